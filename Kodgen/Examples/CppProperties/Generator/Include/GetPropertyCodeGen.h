@@ -18,6 +18,12 @@ class GetPropertyCodeGen : public kodgen::MacroPropertyCodeGen
 			kodgen::MacroPropertyCodeGen("Get", kodgen::EEntityType::Field)
 		{}
 
+		virtual bool supportsReuse() const noexcept override
+		{
+			//This generator doesn't keep any state between files
+			return true;
+		}
+
 		virtual bool preGenerateCodeForEntity(kodgen::EntityInfo const& /* entity */, kodgen::Property const& property, kodgen::uint8 /* propertyIndex */, kodgen::MacroCodeGenEnv& env) noexcept override
 		{
 			std::string errorMessage;
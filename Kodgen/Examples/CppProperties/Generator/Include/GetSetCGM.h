@@ -27,4 +27,10 @@ class GetSetCGM : public kodgen::MacroCodeGenModule
 		{
 			return new GetSetCGM(*this);
 		}
+
+		virtual bool supportsReuse() const noexcept override
+		{
+			//This generator doesn't keep any state between files
+			return true;
+		}
 };
\ No newline at end of file
@@ -7,53 +7,530 @@
 
 #pragma once
 
-#include <set>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <cassert>
+#include <atomic>
+#include <functional>	//std::function
+#include <memory>		//std::shared_ptr, std::unique_ptr
+#include <tuple>		//std::tuple, std::apply
+#include <algorithm>	//std::any_of, std::stable_sort
 #include <type_traits>	//std::is_base_of
 #include <chrono>		//std::chrono::high_resolution_clock
+#include <thread>		//std::this_thread::get_id
 
 #include "Kodgen/Misc/ILogger.h"
+#include "Kodgen/Misc/Optional.h"
+#include "Kodgen/Misc/HashHelpers.h"
+#include "Kodgen/Misc/CompilerHelpers.h"
+#include "Kodgen/Misc/FileWatcher.h"
 #include "Kodgen/CodeGen/CodeGenResult.h"
 #include "Kodgen/CodeGen/CodeGenUnit.h"
+#include "Kodgen/CodeGen/CodeGenManifest.h"
 #include <Kodgen/CodeGen/CodeGenManagerSettings.h>
 #include "Kodgen/Parsing/FileParser.h"
 #include "Kodgen/Threading/ThreadPool.h"
+#include "Kodgen/Threading/TaskGroup.h"
 #include "Kodgen/Threading/TaskHelper.h"
 
 namespace kodgen
 {
 	class CodeGenManager
 	{
+		friend class CodeGenServer;
+
 		private:
+			/** State of a file processed during a generation. */
+			struct ProcessedFile
+			{
+				/** Path to the processed file. */
+				fs::path									path;
+
+				/** Must the unit generate the code of this file? It doesn't if its code is up to date for the unit but not for another one. */
+				bool										shouldGenerate			= true;
+
+				/** Did the code generation of the file succeed for all iterations? */
+				bool										succeeded				= true;
+
+				/**
+				*	Result of the last parsing of the file, shared by all the code generation iterations following it.
+				*	The first parsing is also shared by all the units generating the file.
+				*/
+				std::shared_ptr<FileParsingResult const>	parsingResult;
+
+				/** Files included by this file, retrieved from its last parsing once its last code generation iteration completed. */
+				std::vector<fs::path>						includedFiles;
+
+				/** Indices of the other processed files included by this file, according to the manifest. Used to group files in shards. */
+				std::vector<size_t>							processedDependencies;
+
+				/** Is processedDependencies reliable? It is not if the file is new or has been modified since the last generation. */
+				bool										areDependenciesKnown	= false;
+
+				/** Number of times the file has been parsed. */
+				uint8										parsingCount			= 0u;
+
+				/** Time spent (in seconds) to parse the file, all parsings included. */
+				float										parsingDuration			= 0.0f;
+
+				/** Time spent (in seconds) by the first parsing of the file, shared by all the units generating it. Included in parsingDuration. */
+				float										sharedParsingDuration	= 0.0f;
+
+				/** Does this unit account for the shared parsing in the processing durations? Only the first unit generating the file does. */
+				bool										accountsSharedParsing	= true;
+
+				/** Time spent (in seconds) to generate the code of the file, all iterations included. */
+				float										generationDuration		= 0.0f;
+
+				/** Processing duration (in seconds) predicted before the file is processed, if a prediction could be made. */
+				opt::optional<float>						predictedDuration;
+
+				/** Parsing duration (in seconds) predicted before the file is processed, if the file has a history. Included in predictedDuration. */
+				opt::optional<float>						predictedParsingDuration;
+
+				/** Expected cost of the file processing. Files with the highest cost are scheduled first. */
+				float										schedulingCost			= 0.0f;
+			};
+
+			/** Code generation unit taking part in a generation, whatever its concrete type. */
+			struct ProcessedUnit
+			{
+				/** Model of the unit, used to check whether files are up to date and to retrieve the generation settings. */
+				CodeGenUnit const*								codeGenUnit	= nullptr;
+
+				/**
+				*	Generate the code of a parsed file with the copy of the unit model owned by the calling thread, created on first use and reset
+				*	before each other file, if the unit is reusable. Non-reusable units are copied for each file.
+				*	Returns true if the generation succeeded.
+				*/
+				std::function<bool(FileParsingResult const&, std::unique_ptr<CodeGenUnit>&)>	generateCode;
+
+				/** Manifest of the last generation of the unit, saved in its output directory. */
+				CodeGenManifest									manifest;
+			};
+
+			/** Worker process processing a shard of the files to process during a sharded generation. */
+			struct ShardWorker
+			{
+				/** Process id of the worker. */
+				int													processId		= -1;
+
+				/** Read end of the pipe the worker reports the state of its processed files to, -1 once the worker terminated. */
+				int													pipeDescriptor	= -1;
+
+				/** Data received from the worker which doesn't form a complete report yet. */
+				std::string											receivedData;
+
+				/** Time the worker started or last reported a processed file. */
+				std::chrono::high_resolution_clock::time_point		lastReportTime;
+
+				/** Indices of the files processed by the worker. */
+				std::vector<size_t>									fileIndices;
+
+				/** Generation result of the worker, reported once it processed all its files. */
+				opt::optional<CodeGenResult>						result;
+			};
+
+			/** Maximum time spent waiting for file changes before checking whether watching should stop. */
+			static constexpr std::chrono::milliseconds const	_watchPollingPeriod		= std::chrono::milliseconds(100);
+
+			/** Time without any file change to wait for before regenerating changed files in watch mode. */
+			static constexpr std::chrono::milliseconds const	_watchSettleDelay		= std::chrono::milliseconds(50);
+
+			/** Time after which idle worker threads exit in watch mode. They are spawned again when files must be regenerated. */
+			static constexpr std::chrono::milliseconds const	_watchIdleWorkerTimeout	= std::chrono::seconds(10);
+
 			/** Thread pool used for files processing. */
-			ThreadPool	_threadPool;
+			ThreadPool			_threadPool;
+
+			/** Has stopWatching been called since the last watch returned? */
+			std::atomic_bool	_isStopWatchingRequested	= false;
 
 			/**
-			*	@brief Process all provided files on multiple threads.
+			*	@brief	Regenerate the candidate files which changed since their last generation, then update and save the manifests.
+			*			Each unit checks on its own which files it must regenerate, but a file is parsed once for all the units regenerating it.
 			*	
-			*	@param fileParser		Original file parser to use to parse registered files. A copy of this parser will be used for each generation thread.
-			*	@param codeGenUnit		Generation unit used to generate files. It must have a clean state when this method is called.
-			*	@param toProcessFiles	Collection of all files to process.
-			*	@param out_genResult	Reference to the generation result to fill during file generation.
+			*	@param fileParser							Original file parser to use to parse files. A copy of this parser will be used for each generation thread.
+			*	@param units								Units generating the files. Their manifest is updated with the files they processed.
+			*	@param candidates							Files to regenerate if they are not up to date.
+			*	@param forceRegenerateAll					Ignore the manifest check and reparse / regenerate all candidates.
+			*	@param inout_areParsingSettingsInitialized	Have the parser settings already been initialized? They are initialized only once, when the first file must be parsed.
+			*	@param out_genResult						Reference to the generation result to fill during file generation.
+			*	@param shardCount							Number of worker processes to process files in, or 0 to process files in the current process.
+			*	@param shardFileTimeout						Time after which a worker process which didn't report any processed file is considered hung.
 			*/
-			template <typename FileParserType, typename CodeGenUnitType>
-			void	processFiles(FileParserType&			fileParser,
-								 CodeGenUnitType&			codeGenUnit,
-								 std::set<fs::path> const&	toProcessFiles,
-								 CodeGenResult&				out_genResult)										noexcept;
+			template <typename FileParserType>
+			void	generateFiles(FileParserType&								fileParser,
+								  std::vector<ProcessedUnit>&					units,
+								  std::unordered_set<fs::path, PathHash> const&	candidates,
+								  bool											forceRegenerateAll,
+								  bool&											inout_areParsingSettingsInitialized,
+								  CodeGenResult&								out_genResult,
+								  uint32										shardCount			= 0u,
+								  std::chrono::milliseconds						shardFileTimeout	= std::chrono::milliseconds(0))	noexcept;
+
+			/**
+			*	@brief	Load the manifests, discover the files to process and regenerate the ones which are not up to date.
+			*
+			*	@param fileParser							Original file parser to use to parse files.
+			*	@param units								Units generating code. Their model must have a clean state when this method is called.
+			*	@param forceRegenerateAll					Ignore the manifest check and reparse / regenerate all files.
+			*	@param inout_areParsingSettingsInitialized	Have the parser settings already been initialized? They are initialized only once, when the first file must be parsed.
+			*	@param shardCount							Number of worker processes to process files in, or 0 to process files in the current process.
+			*	@param shardFileTimeout						Time after which a worker process which didn't report any processed file is considered hung.
+			*
+			*	@return Structure containing file generation report.
+			*/
+			template <typename FileParserType>
+			CodeGenResult	runGeneration(FileParserType&				fileParser,
+										  std::vector<ProcessedUnit>&	units,
+										  bool							forceRegenerateAll,
+										  bool&							inout_areParsingSettingsInitialized,
+										  uint32						shardCount,
+										  std::chrono::milliseconds		shardFileTimeout)			noexcept;
+
+			/**
+			*	@brief	Process all provided files in worker processes, with the same result as processFiles.
+			*			Files are split in shardCount shards of similar expected cost, each one processed by a forked worker process
+			*			reporting the state of each processed file through a pipe as soon as it is generated. Processed files including each other
+			*			are kept in the same shard so that the generation iterations of a file still wait for the ones of the files it includes.
+			*			The files not reported by a worker which crashed or hung are then retried one by one, each in its own worker process,
+			*			so that a file crashing libclang only fails itself.
+			*			Each worker reports its generation result once it processed all its files. The parsed files and the processing
+			*			durations of the files of a worker which crashed or hung are deduced from the reports of the files instead.
+			*			The workers of the thread pool are stopped before forking, so that no thread holds a lock the worker processes need.
+			*	
+			*	@param fileParser				Original file parser to use to parse files.
+			*	@param units					Units generating the files.
+			*	@param toProcessFiles			Collection of all files to process.
+			*	@param contentHashes			Content hash of the processed files.
+			*	@param shardCount				Number of worker processes to run concurrently.
+			*	@param fileTimeout				Time after which a worker process which didn't report any processed file is killed.
+			*	@param out_genResult			Reference to the generation result to fill during file generation.
+			*	@param inout_processedFiles		State of each processed file for each unit, in the units and toProcessFiles order.
+			*/
+			template <typename FileParserType>
+			void	processFilesInShards(FileParserType&										fileParser,
+										 std::vector<ProcessedUnit> const&						units,
+										 std::vector<fs::path> const&							toProcessFiles,
+										 std::unordered_map<fs::path, uint64, PathHash> const&	contentHashes,
+										 uint32													shardCount,
+										 std::chrono::milliseconds								fileTimeout,
+										 CodeGenResult&											out_genResult,
+										 std::vector<std::vector<ProcessedFile>>&				inout_processedFiles)	noexcept;
+
+			/**
+			*	@brief	Split the processed files in shards of similar expected cost.
+			*			Files connected by processed dependencies of any unit are always put in the same shard.
+			*	
+			*	@param processedFiles	State of the processed files to split for each unit.
+			*	@param shardCount		Maximum number of shards.
+			*
+			*	@return The indices of the processed files of each shard.
+			*/
+			static std::vector<std::vector<size_t>>	makeShards(std::vector<std::vector<ProcessedFile>> const&	processedFiles,
+															   uint32											shardCount)		noexcept;
+
+			/**
+			*	@brief	Fork a worker process running the provided function.
+			*			The worker process exits as soon as the function returns.
+			*	
+			*	@param work			Function run by the worker process, taking the write end of the pipe to report processed files to.
+			*						The thread pool workers must be stopped, since only the forking thread exists in the worker process.
+			*	@param out_worker	Worker filled with the started process.
+			*
+			*	@return true if the worker process has been started, else false.
+			*/
+			static bool								startShardWorker(std::function<void(int)> const&	work,
+																	 ShardWorker&						out_worker)		noexcept;
+
+			/**
+			*	@brief Write data to the pipe of a worker process, unless the coordinator is gone.
+			*	
+			*	@param pipeDescriptor	Write end of the pipe of the worker.
+			*	@param data				Data to write.
+			*/
+			static void								writeShardPipe(int					pipeDescriptor,
+																   std::string const&	data)						noexcept;
+
+			/**
+			*	@brief Report the state of a processed file from a worker process.
+			*	
+			*	@param pipeDescriptor	Write end of the pipe of the worker.
+			*	@param unitIndex		Index of the unit which processed the file.
+			*	@param processedFile	The processed file.
+			*/
+			static void								writeShardReport(int					pipeDescriptor,
+																	 size_t					unitIndex,
+																	 ProcessedFile const&	processedFile)				noexcept;
+
+			/**
+			*	@brief Report the generation result of a worker process, once it processed all its files.
+			*	
+			*	@param pipeDescriptor	Write end of the pipe of the worker.
+			*	@param result			Generation result of the worker.
+			*/
+			static void								writeShardResult(int					pipeDescriptor,
+																	 CodeGenResult const&	result)						noexcept;
+
+			/**
+			*	@brief Extract the first complete report (processed file or generation result) from the data received from a worker process.
+			*	
+			*	@param inout_worker				Worker which sent the data. The extracted report is removed from its received data.
+			*	@param processedFileIndices		Index of each processed file, by path.
+			*	@param inout_processedFiles		Processed files of each unit, updated with the report.
+			*	@param inout_isReported			Has each processed file been reported by each unit?
+			*
+			*	@return true if a report has been extracted, false if the data doesn't contain a complete report.
+			*/
+			static bool								readShardReport(ShardWorker&											inout_worker,
+																	std::unordered_map<fs::path, size_t, PathHash> const&	processedFileIndices,
+																	std::vector<std::vector<ProcessedFile>>&				inout_processedFiles,
+																	std::vector<std::vector<bool>>&							inout_isReported)	noexcept;
+
+			/**
+			*	@brief	Collect the reports of worker processes until they all terminated.
+			*			Workers which didn't report anything for fileTimeout are killed.
+			*	
+			*	@param workers					Running workers.
+			*	@param fileTimeout				Time after which a worker which didn't report any processed file is killed.
+			*	@param processedFileIndices		Index of each processed file, by path.
+			*	@param inout_processedFiles		Processed files of each unit, updated with the reports.
+			*	@param inout_isReported			Has each processed file been reported by each unit?
+			*
+			*	@return true if all workers terminated, false if polling the workers failed (all running workers are then killed).
+			*/
+			bool									waitShardWorkers(std::vector<ShardWorker>&								workers,
+																	 std::chrono::milliseconds								fileTimeout,
+																	 std::unordered_map<fs::path, size_t, PathHash> const&	processedFileIndices,
+																	 std::vector<std::vector<ProcessedFile>>&				inout_processedFiles,
+																	 std::vector<std::vector<bool>>&						inout_isReported)	noexcept;
+
+			/**
+			*	@brief	Process all provided files on multiple threads.
+			*			Each file is processed by its own chain of tasks (parsing, then each code generation iteration),
+			*			without any barrier between iterations. The parsing result is reused by all code generation iterations,
+			*			unless the code generation unit requires reparsing or the parsing reported compilation errors.
+			*			Since a reparsing might read the code generated for other files, the generation iteration N of a file
+			*			also waits for the generation iteration N - 1 of all the processed files its parsing reported as included.
+			*			These dependencies are added once the file is parsed, and are not needed when the parsing is reused by all iterations.
+			*			Files are scheduled by decreasing expected cost so that long files don't start last and delay the whole generation.
+			*			When several units generate the same file, the file is parsed once and the parsing result is shared by the first
+			*			iteration of all of them. Each unit then goes through its own iterations, so reparsings are never shared.
+			*			Threads which are not workers of the pool all share a single copy of the parser and units, used by the calling thread
+			*			when it runs tasks while waiting. No other thread may run tasks of the pool during the call (asserted in debug).
+			*	
+			*	@param fileParser				Original file parser to use to parse registered files. A copy of this parser will be used for each generation thread.
+			*	@param units					Units generating the files.
+			*	@param toProcessFiles			Collection of all files to process. Each of them must be generated by at least one unit.
+			*	@param inout_processedFiles		State of each processed file for each unit, in the units and toProcessFiles order (see initProcessedFiles).
+			*	@param out_genResult			Reference to the generation result to fill during file generation.
+			*	@param onFileProcessed			Function called with the unit index and the state of each file once the last code generation iteration
+			*									of the unit completed. It is called from the threads running the tasks, so it might be called concurrently. Can be empty.
+			*/
+			template <typename FileParserType>
+			void	processFiles(FileParserType&												fileParser,
+								 std::vector<ProcessedUnit> const&								units,
+								 std::vector<fs::path> const&									toProcessFiles,
+								 std::vector<std::vector<ProcessedFile>>&						inout_processedFiles,
+								 CodeGenResult&													out_genResult,
+								 std::function<void(size_t, ProcessedFile const&)> const&		onFileProcessed = nullptr)	noexcept;
+
+			/**
+			*	@brief Make a unit taking part in a generation from a code generation unit model.
+			*	
+			*	@param codeGenUnit Generation unit model. It must outlive the returned unit.
+			*
+			*	@return The unit, with an empty manifest.
+			*/
+			template <typename CodeGenUnitType>
+			static ProcessedUnit	makeProcessedUnit(CodeGenUnitType& codeGenUnit)	noexcept;
 
 			/**
-			*	@brief Identify all files which will be parsed & regenerated.
+			*	@brief	Collect all the files to process: the files explicitly added to the settings, and the files with a supported
+			*			extension contained (recursively) in the directories to process, except ignored ones.
+			*			Directories are walked in parallel on the thread pool, one task per directory.
+			*	
+			*	@param out_files Set filled with the canonical path of all the files to process.
+			*/
+			void					discoverFiles(std::unordered_set<fs::path, PathHash>& out_files)							noexcept;
+
+			/**
+			*	@brief	Collect the files to process contained in a directory and submit a task for each of its subdirectories.
+			*	
+			*	@param directory		The directory to walk.
+			*	@param isCanonicalPath	Is directory a canonical path? It is not if a symbolic link has been followed to reach it.
+			*	@param discoveryGroup	Group the subdirectories tasks are submitted to.
+			*	@param filesMutex		Mutex protecting out_files.
+			*	@param out_files		Vector filled with the discovered files.
+			*/
+			void					discoverDirectoryFiles(fs::path const&			directory,
+														   bool						isCanonicalPath,
+														   TaskGroup&				discoveryGroup,
+														   std::mutex&				filesMutex,
+														   std::vector<fs::path>&	out_files)											noexcept;
+
+			/**
+			*	@brief	Watch all the directories to process (recursively) and the directories containing the files to process.
+			*	
+			*	@param watcher					Watcher to register the directories to.
+			*	@param outputDirectory			Canonical path to the output directory, which is never watched.
+			*	@param out_processedDirectories	Set filled with the canonical path of the watched directories to process.
+			*	@param out_processedFiles		Set filled with the canonical path of the files to process explicitly added to the settings.
+			*/
+			void					watchProcessedPaths(FileWatcher&							watcher,
+														fs::path const&							outputDirectory,
+														std::unordered_set<fs::path, PathHash>&	out_processedDirectories,
+														std::unordered_set<fs::path, PathHash>&	out_processedFiles)			noexcept;
+
+			/**
+			*	@brief	Watch the directories containing the files included by the processed files, so that editing a header
+			*			outside of the directories to process regenerates the files including it.
+			*			Generated files and system headers are not expected to be edited, so their directories are not watched.
+			*	
+			*	@param watcher							Watcher to register the directories to.
+			*	@param manifest							Manifest recording the dependencies of the processed files.
+			*	@param outputDirectory					Canonical path to the output directory, which is never watched.
+			*	@param systemDirectories				Canonical path to the compiler native include directories.
+			*	@param inout_dependencyDirectories		Set of the directories already considered, filled with the newly considered ones.
+			*/
+			void					watchDependencyDirectories(FileWatcher&								watcher,
+															   CodeGenManifest const&					manifest,
+															   fs::path const&							outputDirectory,
+															   std::vector<fs::path> const&				systemDirectories,
+															   std::unordered_set<fs::path, PathHash>&	inout_dependencyDirectories)	noexcept;
+
+			/**
+			*	@brief	Collect the files to regenerate after some files changed: the changed files which are files to process,
+			*			and all the files including any changed file according to the manifest. Deleted files are removed from the manifest.
+			*	
+			*	@param changedFiles			Files reported by the file watcher.
+			*	@param processedDirectories	Watched directories to process.
+			*	@param processedFiles		Files to process explicitly added to the settings.
+			*	@param manifest				Manifest of the last generation.
+			*	@param out_candidates		Set filled with the files to regenerate if they are not up to date.
+			*/
+			void					collectChangedFiles(std::vector<fs::path> const&					changedFiles,
+														std::unordered_set<fs::path, PathHash> const&	processedDirectories,
+														std::unordered_set<fs::path, PathHash> const&	processedFiles,
+														CodeGenManifest&								manifest,
+														std::unordered_set<fs::path, PathHash>&			out_candidates)		noexcept;
+
+			/**
+			*	@brief	Create the state of each file to process, then fill their processed dependencies and predict their processing duration.
+			*	
+			*	@param toProcessFiles		Collection of all files to process.
+			*	@param manifest				Manifest of the last generation.
+			*	@param contentHashes		Content hash of the processed files.
+			*	@param out_processedFiles	Collection filled with the state of each processed file, in the toProcessFiles order.
+			*/
+			static void				initProcessedFiles(std::vector<fs::path> const&							toProcessFiles,
+													   CodeGenManifest const&									manifest,
+													   std::unordered_map<fs::path, uint64, PathHash> const&	contentHashes,
+													   std::vector<ProcessedFile>&								out_processedFiles)	noexcept;
+
+			/**
+			*	@brief	Fill the processed dependencies of each processed file from the manifest.
+			*			Dependencies recorded in the manifest are only reliable if the file content didn't change since they were recorded.
+			*	
+			*	@param manifest				Manifest of the last generation.
+			*	@param contentHashes		Content hash of the processed files.
+			*	@param inout_processedFiles	Processed files to fill the dependencies of.
+			*/
+			static void				collectProcessedDependencies(CodeGenManifest const&									manifest,
+																 std::unordered_map<fs::path, uint64, PathHash> const&	contentHashes,
+																 std::vector<ProcessedFile>&							inout_processedFiles)	noexcept;
+
+			/**
+			*	@brief	Identify all files which will be parsed & regenerated.
+			*			A file is regenerated if its generated files are missing, or if its content, the content of any
+			*			of the files it includes or the generation fingerprint changed since the last generation recorded in the manifest.
 			*	
 			*	@param codeGenUnit			Generation unit used to determine whether a file should be reparsed/regenerated or not.
-			*	@param out_genResult		Reference to the generation result to fill during file generation.
-			*	@param forceRegenerateAll	Should all files be regenerated or not (regardless of CodeGenManager::shouldRegenerateFile() returned value).
+			*	@param candidates			Files to regenerate if they are not up to date.
+			*	@param manifest				Manifest of the last generation.
+			*	@param fingerprint			Fingerprint of the current generation setup.
+			*	@param inout_contentHashes	Map filled with the content hash of each candidate file and of each of their recorded dependencies.
+			*								Files already in the map are not hashed again.
+			*	@param forceRegenerateAll	Should all files be regenerated or not (regardless of the manifest content).
 			*
-			*	@return A collection of all files which will be regenerated.
+			*	@return A collection of all files which will be regenerated, sorted by path.
+			*/
+			std::vector<fs::path>	identifyFilesToProcess(CodeGenUnit const&								codeGenUnit,
+														   std::unordered_set<fs::path, PathHash> const&	candidates,
+														   CodeGenManifest const&							manifest,
+														   uint64											fingerprint,
+														   std::unordered_map<fs::path, uint64, PathHash>&	inout_contentHashes,
+														   bool												forceRegenerateAll)	noexcept;
+
+			/**
+			*	@brief	Predict the processing duration of each processed file and compute its scheduling cost.
+			*			The prediction is the duration measured during the last generation of the file if any, otherwise the file size
+			*			scaled by the average processing speed of the files with a history. If no file has a history, files are
+			*			scheduled by size without any prediction.
+			*	
+			*	@param manifest				Manifest of the last generation.
+			*	@param inout_processedFiles	Processed files to predict the processing duration of.
+			*/
+			static void				predictProcessingDurations(CodeGenManifest const&		manifest,
+															   std::vector<ProcessedFile>&	inout_processedFiles)					noexcept;
+
+			/**
+			*	@brief	Make the first unit generating each file the only one accounting for the parsing shared by all the units generating it,
+			*			so that the parsing is counted once in the scheduling costs and in the reported processing durations.
+			*	
+			*	@param inout_processedFiles Processed files of each unit, in the same order for all units.
+			*/
+			static void				shareParsingDurations(std::vector<std::vector<ProcessedFile>>& inout_processedFiles)				noexcept;
+
+			/**
+			*	@brief Report how well the processing durations of the processed files were predicted.
+			*	
+			*	@param processedFiles	Processed files.
+			*	@param out_genResult	Generation result to fill the prediction report of.
 			*/
-			std::set<fs::path>		identifyFilesToProcess(CodeGenUnit const&	codeGenUnit,
-														   CodeGenResult&		out_genResult,
-														   bool					forceRegenerateAll)				noexcept;
+			static void				reportProcessingDurations(std::vector<ProcessedFile> const&	processedFiles,
+															  CodeGenResult&						out_genResult)				noexcept;
+
+			/**
+			*	@brief Report how well the processing duration of a processed file was predicted.
+			*	
+			*	@param processedFile	Processed file.
+			*	@param out_genResult	Generation result to fill the prediction report of.
+			*/
+			static void				reportProcessingDuration(ProcessedFile const&	processedFile,
+															 CodeGenResult&			out_genResult)								noexcept;
+
+			/**
+			*	@brief	Hash the content of the provided files on the thread pool.
+			*			Files which can't be read are not added to out_contentHashes.
+			*	
+			*	@param files				Files to hash.
+			*	@param out_contentHashes	Map filled with the content hash of each file.
+			*/
+			void					hashFiles(std::vector<fs::path> const&						files,
+											  std::unordered_map<fs::path, uint64, PathHash>&	out_contentHashes)			noexcept;
+
+			/**
+			*	@brief	Record the state of all processed files in the manifest and save it.
+			*			Successfully regenerated files are recorded along with the hash of all the files they include,
+			*			while failed files are removed from the manifest so that they are regenerated next time.
+			*	
+			*	@param manifest				Manifest to update.
+			*	@param manifestFile			Path to the file the manifest is saved to.
+			*	@param fingerprint			Fingerprint of the current generation setup.
+			*	@param outputDirectory		Directory containing the generated files. Generated files are never recorded as dependencies.
+			*	@param processedFiles		State of each processed file.
+			*	@param inout_contentHashes	Content hash of the known files. Dependencies which haven't been hashed yet are hashed and added to the map.
+			*/
+			void					updateManifest(CodeGenManifest&									manifest,
+												   fs::path const&									manifestFile,
+												   uint64											fingerprint,
+												   fs::path const&									outputDirectory,
+												   std::vector<ProcessedFile> const&				processedFiles,
+												   std::unordered_map<fs::path, uint64, PathHash>&	inout_contentHashes)			noexcept;
 
 			/**
 			*	@brief	Get the number of threads to use based on the provided thread count.
@@ -96,19 +573,21 @@ namespace kodgen
 			/**
 			*	@brief Construct a CodeGenManager that will work with the specified number of threads.
 			* 
-			*	@param threadCount	Number of threads to use for file parsing and generation.
+			*	@param threadCount	Number of threads to use for file parsing and generation, including the thread calling run, which processes files too.
 			*							If 0 is provided, the number of concurrent threads supported by the implementation will be used (std::thread::hardware_concurrency(), and 8 if std::thread::hardware_concurrency() returns 0).
-			*							If 1 is provided, all the process will be handled by the main thread.
+			*							If 1 is provided, no thread is spawned and all the process is handled by the calling thread, without going through the thread pool.
 			*/
 			CodeGenManager(uint32 threadCount = 0u)	noexcept;
 
 			/**
 			*	@brief	Parse registered files if they were modified since last generation (or don't exist)
 			*			and forward them to individual file generation unit for code generation.
+			*			Modifications are detected by comparing file contents and settings with the manifest
+			*			saved in the code generation unit output directory.
 			*
 			*	@param fileParser			Original file parser to use to parse registered files. A copy of this parser will be used for each generation thread.
 			*	@param codeGenUnit			Generation unit used to generate code. It must have a clean state when this method is called.
-			*	@param forceRegenerateAll	Ignore the last write time check and reparse / regenerate all files.
+			*	@param forceRegenerateAll	Ignore the manifest check and reparse / regenerate all files.
 			*
 			*	@return Structure containing file generation report.
 			*/
@@ -116,6 +595,78 @@ namespace kodgen
 			CodeGenResult run(FileParserType&	fileParser,
 							  CodeGenUnitType&	codeGenUnit,
 							  bool				forceRegenerateAll	= false)	noexcept;
+
+			/**
+			*	@brief	Same as run, but with several code generation units generating code from the same files, for example
+			*			a reflection unit and a serialization unit. Each unit has its own output directory and manifest, so it only
+			*			regenerates the files which are not up to date for itself, but each file is parsed only once for all the
+			*			units regenerating it.
+			*
+			*	@param fileParser			Original file parser to use to parse registered files. A copy of this parser will be used for each generation thread.
+			*	@param codeGenUnits			Generation units used to generate code, usually created with std::tie. They must have a clean state when this method is called.
+			*	@param forceRegenerateAll	Ignore the manifest checks and reparse / regenerate all files.
+			*
+			*	@return Structure containing file generation report.
+			*/
+			template <typename FileParserType, typename... CodeGenUnitTypes>
+			CodeGenResult	run(FileParserType&						fileParser,
+								std::tuple<CodeGenUnitTypes&...>	codeGenUnits,
+								bool								forceRegenerateAll	= false)	noexcept;
+
+			/**
+			*	@brief	Same as run, except that files are parsed and generated in worker processes instead of threads.
+			*			A crash or a hang of libclang in a worker process only fails the file which caused it, and the workers
+			*			don't compete for the process-wide resources of libclang. Only supported on Unix systems: on Windows,
+			*			this method logs a warning and behaves like run.
+			*
+			*	@param fileParser			Original file parser to use to parse registered files.
+			*	@param codeGenUnit			Generation unit used to generate code. It must have a clean state when this method is called.
+			*	@param shardCount			Number of worker processes. If 0 is provided, the number of concurrent threads supported by the implementation is used (see getThreadCount).
+			*	@param forceRegenerateAll	Ignore the manifest check and reparse / regenerate all files.
+			*	@param fileTimeout			Time after which a worker process which didn't report any processed file is considered hung and is killed.
+			*
+			*	@return Structure containing file generation report.
+			*/
+			template <typename FileParserType, typename CodeGenUnitType>
+			CodeGenResult	runSharded(FileParserType&				fileParser,
+									   CodeGenUnitType&				codeGenUnit,
+									   uint32						shardCount			= 0u,
+									   bool							forceRegenerateAll	= false,
+									   std::chrono::milliseconds	fileTimeout			= std::chrono::minutes(2))	noexcept;
+
+			/**
+			*	@brief	Generate the files which changed since the last generation like run, then watch the files and directories to process
+			*			and regenerate files as soon as they, or any file they include, change, until stopWatching is called.
+			*			The thread pool, the initialized parser settings and the manifest are kept alive between generations,
+			*			and directories are not walked again: only the changed files and the files including them are checked.
+			*			The directories of the included files are watched as well, except the compiler native include directories.
+			*			Files are watched with inotify, so this method is only supported on Linux.
+			*
+			*	@param fileParser				Original file parser to use to parse files. A copy of this parser will be used for each generation thread.
+			*	@param codeGenUnit				Generation unit used to generate code. It must have a clean state when this method is called.
+			*	@param onGenerationCompleted	Function called with the report of each generation, including the first one. Can be empty.
+			*
+			*	@return false if the generation setup is invalid or files can't be watched on this platform, else true once watching stopped.
+			*/
+			template <typename FileParserType, typename CodeGenUnitType>
+			bool			watch(FileParserType&									fileParser,
+								  CodeGenUnitType&									codeGenUnit,
+								  std::function<void(CodeGenResult const&)> const&	onGenerationCompleted = nullptr)	noexcept;
+
+			/**
+			*	@brief	Make the running watch call return once the ongoing generation, if any, completes.
+			*			If no watch call is running, the next one returns after its first generation.
+			*			This method can be called from any thread, including from the onGenerationCompleted callback.
+			*/
+			void			stopWatching()																				noexcept;
+
+			/**
+			*	@brief	Make the worker threads exit when they have nothing to do for some time, so that a manager kept alive between
+			*			generations doesn't keep idle threads. Worker threads are spawned again as soon as files must be processed.
+			*
+			*	@param idleTimeout Time after which an idle worker thread exits, or 0 to keep worker threads alive.
+			*/
+			void			setIdleWorkerTimeout(std::chrono::milliseconds idleTimeout)									noexcept;
 	};
 
 	#include "Kodgen/CodeGen/CodeGenManager.inl"
@@ -5,118 +5,900 @@
 *	See the LICENSE.md file for full license details.
 */
 
-template <typename FileParserType, typename CodeGenUnitType>
-void CodeGenManager::processFiles(FileParserType& fileParser, CodeGenUnitType& codeGenUnit, std::set<fs::path> const& toProcessFiles, CodeGenResult& out_genResult) noexcept
+template <typename FileParserType>
+void CodeGenManager::processFiles(FileParserType& fileParser, std::vector<ProcessedUnit> const& units, std::vector<fs::path> const& toProcessFiles,
+								  std::vector<std::vector<ProcessedFile>>& inout_processedFiles, CodeGenResult& out_genResult,
+								  std::function<void(size_t, ProcessedFile const&)> const& onFileProcessed) noexcept
 {
-	std::vector<std::shared_ptr<TaskBase>>	generationTasks;
-	uint8									iterationCount = codeGenUnit.getIterationCount();
+	//Each task only accesses the state of its own file, so no synchronization is required
+	//The vectors must never reallocate since tasks reference their elements
+	size_t	fileCount			= toProcessFiles.size();
+	uint8	maxIterationCount	= 0u;
 
-	//Reserve enough space for all tasks
-	generationTasks.reserve(toProcessFiles.size() * iterationCount);
+	//A file costs the processing of all the units generating it, its shared parsing only being part of the cost of the first one
+	std::vector<float> schedulingCosts(fileCount, 0.0f);
 
-	//Launch all parsing -> generation processes
-	std::shared_ptr<TaskBase> parsingTask;
-	
-	for (int i = 0; i < iterationCount; i++)
+	for (size_t unitIndex = 0u; unitIndex < units.size(); unitIndex++)
 	{
-		//Lock the thread pool until all tasks have been pushed to avoid competing for the tasks mutex
-		_threadPool.setIsRunning(false);
+		maxIterationCount = std::max(maxIterationCount, units[unitIndex].codeGenUnit->getIterationCount());
 
-		for (fs::path const& file : toProcessFiles)
+		for (size_t fileIndex = 0u; fileIndex < fileCount; fileIndex++)
 		{
-			auto parsingTaskLambda = [&fileParser, &file](TaskBase*) -> FileParsingResult
+			ProcessedFile const& processedFile = inout_processedFiles[unitIndex][fileIndex];
+
+			if (processedFile.shouldGenerate)
 			{
-				//Copy a parser for this task
-				FileParserType		fileParserCopy = fileParser;
-				FileParsingResult	parsingResult;
+				schedulingCosts[fileIndex] += processedFile.schedulingCost;
+			}
+		}
+	}
+
+	//Workers pick the first ready task of the highest priority, so submitting the most expensive files first schedules their parsing first (longest processing time first)
+	std::vector<size_t> processingOrder(fileCount);
+
+	for (size_t fileIndex = 0u; fileIndex < processingOrder.size(); fileIndex++)
+	{
+		processingOrder[fileIndex] = fileIndex;
+	}
+
+	std::stable_sort(processingOrder.begin(), processingOrder.end(), [&schedulingCosts](size_t lhs, size_t rhs)
+					 {
+						 return schedulingCosts[lhs] > schedulingCosts[rhs];
+					 });
+
+	//Each thread parses with its own copy of the parser, so that parsers and their clang index are created once per thread for the whole run.
+	//The parser resets its parsing state for each file. All the threads which are not workers share the last parser, which is only safe
+	//as long as the calling thread, waiting for the processing group, is the only one of them running tasks of the pool.
+	std::vector<std::unique_ptr<FileParserType>> threadFileParsers(_threadPool.getMaxWorkerCount() + 1u);
+
+	std::thread::id const callingThreadId = std::this_thread::get_id();
+
+	auto getThreadIndex = [this, callingThreadId]()
+	{
+		uint32 workerIndex = _threadPool.getCurrentWorkerIndex();
+
+		assert(workerIndex != _threadPool.getMaxWorkerCount() || std::this_thread::get_id() == callingThreadId);	//Another thread runs tasks of the pool
+
+		return workerIndex;
+	};
+
+	auto parseFile = [&fileParser, &threadFileParsers, &getThreadIndex](fs::path const& file, float& inout_parsingDuration)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+
+		std::unique_ptr<FileParserType>&	threadFileParser	= threadFileParsers[getThreadIndex()];
+		std::shared_ptr<FileParsingResult>	parsingResult		= std::make_shared<FileParsingResult>();
+
+		if (threadFileParser == nullptr)
+		{
+			threadFileParser = std::make_unique<FileParserType>(fileParser);
+		}
+
+		threadFileParser->parse(file, *parsingResult);
 
-				fileParserCopy.parse(file, parsingResult);
+		inout_parsingDuration += std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - start).count();
 
-				return parsingResult;
-			};
+		return parsingResult;
+	};
 
-			auto generationTaskLambda = [&codeGenUnit](TaskBase* parsingTask) -> CodeGenResult
+	//Parse a file once for all the units generating it
+	auto parseSharedFile = [&parseFile, &toProcessFiles, &inout_processedFiles](size_t fileIndex)
+	{
+		float								parsingDuration	= 0.0f;
+		std::shared_ptr<FileParsingResult>	parsingResult	= parseFile(toProcessFiles[fileIndex], parsingDuration);
+
+		for (std::vector<ProcessedFile>& processedFiles : inout_processedFiles)
+		{
+			ProcessedFile& processedFile = processedFiles[fileIndex];
+
+			if (processedFile.shouldGenerate)
 			{
-				CodeGenResult out_generationResult;
+				processedFile.parsingCount++;
+				processedFile.parsingResult			= parsingResult;
+				processedFile.parsingDuration		+= parsingDuration;
+				processedFile.sharedParsingDuration	= parsingDuration;
+			}
+		}
+	};
+
+	//Each thread generates files with its own copy of each unit as well, indexed like the parsers
+	std::vector<std::vector<std::unique_ptr<CodeGenUnit>>> threadCodeGenUnits(units.size());
 
-				//Copy the generation unit model to have a fresh one for this generation unit
-				CodeGenUnitType	generationUnit = codeGenUnit;
+	for (std::vector<std::unique_ptr<CodeGenUnit>>& unitThreadCodeGenUnits : threadCodeGenUnits)
+	{
+		unitThreadCodeGenUnits.resize(threadFileParsers.size());
+	}
+
+	//Run an iteration of a unit on a parsed file
+	auto generateFile = [&units, &inout_processedFiles, &parseFile, &onFileProcessed, &threadCodeGenUnits, &getThreadIndex](size_t unitIndex, size_t fileIndex, uint8 iteration) -> CodeGenResult
+	{
+		ProcessedUnit const&	unit			= units[unitIndex];
+		ProcessedFile&			processedFile	= inout_processedFiles[unitIndex][fileIndex];
+		CodeGenResult			out_generationResult;
+
+		//Reuse the previous parsing result unless a module requires a fresh parsing or the previous parsing was incomplete.
+		//The new parsing result is only used by this unit.
+		if (iteration != 0u && (unit.codeGenUnit->shouldReparseBetweenIterations() || processedFile.parsingResult->hasCompilationErrors))
+		{
+			processedFile.parsingCount++;
+			processedFile.parsingResult = parseFile(processedFile.path, processedFile.parsingDuration);
 
-				//Get the result of the parsing task
-				FileParsingResult parsingResult = TaskHelper::getDependencyResult<FileParsingResult>(parsingTask, 0u);
+			out_generationResult.parsedFiles.push_back(processedFile.path);
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+
+		//Generate the file if no errors occured during parsing
+		if (processedFile.parsingResult->errors.empty())
+		{
+			out_generationResult.completed = unit.generateCode(*processedFile.parsingResult, threadCodeGenUnits[unitIndex][getThreadIndex()]);
+		}
+
+		if (!out_generationResult.completed)
+		{
+			processedFile.succeeded = false;
+		}
+
+		processedFile.generationDuration += std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - start).count();
+
+		//Release the parsing result as soon as possible, only the included files are required once the file has been generated.
+		//A shared parsing result is destroyed once all the units sharing it released it.
+		if (iteration + 1u == unit.codeGenUnit->getIterationCount())
+		{
+			processedFile.includedFiles = processedFile.parsingResult->includedFiles;
+			processedFile.parsingResult.reset();
 
-				//Generate the file if no errors occured during parsing
-				if (parsingResult.errors.empty())
+			if (onFileProcessed)
+			{
+				onFileProcessed(unitIndex, processedFile);
+			}
+		}
+
+		return out_generationResult;
+	};
+
+	//Without any worker, or with a single file which tasks would mostly run one after the other, the current thread processes the files directly
+	//instead of going through the thread pool
+	if (_threadPool.getWorkerCount() == 0u || fileCount <= 1u)
+	{
+		//All files go through an iteration before any file goes through the next one, so the dependencies between iterations are always met
+		for (uint8 i = 0u; i < maxIterationCount; i++)
+		{
+			for (size_t fileIndex : processingOrder)
+			{
+				if (i == 0u)
 				{
-					out_generationResult.completed = generationUnit.generateCode(parsingResult);
+					out_genResult.parsedFiles.push_back(toProcessFiles[fileIndex]);
+
+					parseSharedFile(fileIndex);
 				}
 
-				return out_generationResult;
-			};
+				for (size_t unitIndex = 0u; unitIndex < units.size(); unitIndex++)
+				{
+					if (i < units[unitIndex].codeGenUnit->getIterationCount() && inout_processedFiles[unitIndex][fileIndex].shouldGenerate)
+					{
+						out_genResult.mergeResult(generateFile(unitIndex, fileIndex, i));
+					}
+				}
+			}
+		}
 
-			//Add file to the list of parsed files before starting the task to avoid having to synchronize threads
-			out_genResult.parsedFiles.push_back(file);
+		for (size_t unitIndex = 0u; unitIndex < units.size(); unitIndex++)
+		{
+			reportProcessingDurations(inout_processedFiles[unitIndex], out_genResult);
+		}
+
+		return;
+	}
+
+	//Tasks are stored unit by unit, file by file, iteration by iteration
+	std::vector<std::vector<std::shared_ptr<TaskBase>>> generationTasks(units.size());
+
+	for (size_t unitIndex = 0u; unitIndex < units.size(); unitIndex++)
+	{
+		generationTasks[unitIndex].resize(fileCount * units[unitIndex].codeGenUnit->getIterationCount());
+	}
+
+	std::unordered_map<fs::path, size_t, PathHash> fileIndices;
+
+	for (size_t fileIndex = 0u; fileIndex < fileCount; fileIndex++)
+	{
+		fileIndices.emplace(toProcessFiles[fileIndex], fileIndex);
+	}
 
-			//Parse files
-			//For multiple iterations on a same file, the parsing task depends on the previous generation task for the same file
-			parsingTask = _threadPool.submitTask(std::string("Parsing ") + std::to_string(i), parsingTaskLambda);
+	TaskGroup processingGroup(_threadPool);
 
-			//Generate code
-			generationTasks.emplace_back(_threadPool.submitTask(std::string("Generation ") + std::to_string(i), generationTaskLambda, { parsingTask }));
+	//A reparsing might read the code generated for the included files, so once a file is parsed, its iteration N also waits for the iteration N - 1
+	//of the processed files it includes. The tasks of the iterations following the first one are only submitted then, with these dependencies.
+	auto submitNextIterations = [&units, &inout_processedFiles, &generationTasks, &fileIndices, &processingGroup](size_t fileIndex)
+	{
+		std::vector<std::shared_ptr<TaskBase>> nextIterationTasks;
+
+		for (size_t unitIndex = 0u; unitIndex < units.size(); unitIndex++)
+		{
+			ProcessedFile const&					processedFile	= inout_processedFiles[unitIndex][fileIndex];
+			std::vector<std::shared_ptr<TaskBase>>&	unitTasks		= generationTasks[unitIndex];
+			uint8									iterationCount	= units[unitIndex].codeGenUnit->getIterationCount();
+
+			if (!processedFile.shouldGenerate || iterationCount <= 1u)
+			{
+				continue;
+			}
+
+			//A parsing without errors is reused by all the iterations of a unit which doesn't reparse, so it never reads generated code
+			if (units[unitIndex].codeGenUnit->shouldReparseBetweenIterations() || processedFile.parsingResult->hasCompilationErrors)
+			{
+				for (fs::path const& includedFile : processedFile.parsingResult->includedFiles)
+				{
+					auto it = fileIndices.find(includedFile);
+
+					//Files which are up to date for this unit have not been generated again
+					if (it != fileIndices.cend() && it->second != fileIndex && inout_processedFiles[unitIndex][it->second].shouldGenerate)
+					{
+						for (uint8 i = 1u; i < iterationCount; i++)
+						{
+							unitTasks[fileIndex * iterationCount + i]->addDependency(unitTasks[it->second * iterationCount + i - 1u]);
+						}
+					}
+				}
+			}
+
+			for (uint8 i = 1u; i < iterationCount; i++)
+			{
+				nextIterationTasks.push_back(unitTasks[fileIndex * iterationCount + i]);
+			}
+		}
+
+		if (!nextIterationTasks.empty())
+		{
+			processingGroup.submitTasks(nextIterationTasks);
 		}
+	};
+
+	//Parsing and first iteration tasks are submitted at once when they have all been created, so that workers don't compete with the submission
+	std::vector<std::shared_ptr<TaskBase>> tasks;
 
-		//Wait for this iteration to complete before continuing any further
-		//(an iteration N depends on the iteration N - 1)
-		_threadPool.setIsRunning(true);
-		_threadPool.joinWorkers();
+	for (size_t fileIndex : processingOrder)
+	{
+		//Add file to the list of parsed files before starting the task to avoid having to synchronize threads
+		out_genResult.parsedFiles.push_back(toProcessFiles[fileIndex]);
+
+		std::shared_ptr<TaskBase> parsingTask = ThreadPool::createTask("Parsing", [&parseSharedFile, &submitNextIterations, fileIndex](TaskBase*)
+																	   {
+																		   parseSharedFile(fileIndex);
+																		   submitNextIterations(fileIndex);
+																	   });
+		tasks.push_back(parsingTask);
+
+		for (size_t unitIndex = 0u; unitIndex < units.size(); unitIndex++)
+		{
+			std::vector<std::shared_ptr<TaskBase>>&	unitTasks		= generationTasks[unitIndex];
+			uint8									iterationCount	= units[unitIndex].codeGenUnit->getIterationCount();
+
+			if (!inout_processedFiles[unitIndex][fileIndex].shouldGenerate)
+			{
+				continue;
+			}
+
+			//Each file progresses through the iterations of each unit independently from the other files and units:
+			//iteration N of a file follows its iteration N - 1, or its parsing for the first iteration.
+			//Generating a parsed file releases its parsing result and writes its generated files, which a build might be waiting for,
+			//so generation tasks run before the parsing of new files
+			for (uint8 i = 0u; i < iterationCount; i++)
+			{
+				unitTasks[fileIndex * iterationCount + i] = ThreadPool::createTask("Generation", [&generateFile, unitIndex, fileIndex, i](TaskBase*)
+																					{
+																						return generateFile(unitIndex, fileIndex, i);
+																					}, { (i == 0u) ? parsingTask : unitTasks[fileIndex * iterationCount + i - 1u] }, ETaskPriority::High);
+			}
+
+			tasks.push_back(unitTasks[fileIndex * iterationCount]);
+		}
 	}
 
+	processingGroup.submitTasks(tasks);
+
+	//The current thread processes files too instead of waiting idle
+	processingGroup.wait();
+
 	//Merge all generation results together
-	for (std::shared_ptr<TaskBase>& task : generationTasks)
+	for (size_t unitIndex = 0u; unitIndex < units.size(); unitIndex++)
 	{
-		out_genResult.mergeResult(TaskHelper::getResult<CodeGenResult>(task.get()));
+		for (std::shared_ptr<TaskBase> const& task : generationTasks[unitIndex])
+		{
+			//Files which are up to date for the unit don't have any task
+			if (task != nullptr)
+			{
+				out_genResult.mergeResult(TaskHelper::getResult<CodeGenResult>(task.get()));
+			}
+		}
+
+		reportProcessingDurations(inout_processedFiles[unitIndex], out_genResult);
 	}
 }
 
-template <typename FileParserType, typename CodeGenUnitType>
-CodeGenResult CodeGenManager::run(FileParserType& fileParser, CodeGenUnitType& codeGenUnit, bool forceRegenerateAll) noexcept
+template <typename CodeGenUnitType>
+CodeGenManager::ProcessedUnit CodeGenManager::makeProcessedUnit(CodeGenUnitType& codeGenUnit) noexcept
+{
+	//Check FileGenerationUnit validity
+	static_assert(std::is_base_of_v<CodeGenUnit, CodeGenUnitType>, "codeGenUnit type must be a derived class of kodgen::CodeGenUnit.");
+	static_assert(std::is_copy_constructible_v<CodeGenUnitType>, "The CodeGenUnit you provide must be copy-constructible.");
+
+	ProcessedUnit unit;
+
+	unit.codeGenUnit	= &codeGenUnit;
+	unit.generateCode	= [&codeGenUnit, isReusable = codeGenUnit.isReusable()](FileParsingResult const& parsingResult, std::unique_ptr<CodeGenUnit>& inout_threadUnit)
+	{
+		//Units which don't support reuse might keep state between files, so copy the generation unit model for each file
+		if (!isReusable)
+		{
+			CodeGenUnitType generationUnit = codeGenUnit;
+
+			return generationUnit.generateCode(parsingResult);
+		}
+
+		//Copy the generation unit model (and clone its modules) once per thread, then reset the copy between files
+		if (inout_threadUnit == nullptr)
+		{
+			inout_threadUnit = std::make_unique<CodeGenUnitType>(codeGenUnit);
+		}
+		else
+		{
+			inout_threadUnit->resetGenerationState();
+		}
+
+		return inout_threadUnit->generateCode(parsingResult);
+	};
+
+	return unit;
+}
+
+template <typename FileParserType>
+void CodeGenManager::generateFiles(FileParserType& fileParser, std::vector<ProcessedUnit>& units, std::unordered_set<fs::path, PathHash> const& candidates, bool forceRegenerateAll,
+								   bool& inout_areParsingSettingsInitialized, CodeGenResult& out_genResult, uint32 shardCount, std::chrono::milliseconds shardFileTimeout) noexcept
 {
 	//Check FileParser validity
 	static_assert(std::is_base_of_v<FileParser, FileParserType>, "fileParser type must be a derived class of kodgen::FileParser.");
 	static_assert(std::is_copy_constructible_v<FileParserType>, "The provided file parser must be copy-constructible.");
 
-	//Check FileGenerationUnit validity
-	static_assert(std::is_base_of_v<CodeGenUnit, CodeGenUnitType>, "codeGenUnit type must be a derived class of kodgen::CodeGenUnit.");
-	static_assert(std::is_copy_constructible_v<CodeGenUnitType>, "The CodeGenUnit you provide must be copy-constructible.");
+	uint64											parserFingerprint = fileParser.getSettings().computeFingerprint();
+	std::vector<uint64>								fingerprints;
+	std::vector<std::vector<fs::path>>				unitFilesToProcess;
+	std::unordered_map<fs::path, uint64, PathHash>	contentHashes;
+	std::unordered_set<fs::path, PathHash>			filesToProcessSet;
 
-	CodeGenResult genResult;
-	genResult.completed = true;
+	//Each unit checks its own manifest, but files are hashed only once for all units
+	for (ProcessedUnit const& unit : units)
+	{
+		fingerprints.push_back(HashHelpers::combine(parserFingerprint, unit.codeGenUnit->computeFingerprint()));
+		unitFilesToProcess.emplace_back(identifyFilesToProcess(*unit.codeGenUnit, candidates, unit.manifest, fingerprints.back(), contentHashes, forceRegenerateAll));
 
-	if (!checkGenerationSetup(fileParser, codeGenUnit))
+		for (fs::path const& file : unitFilesToProcess.back())
+		{
+			filesToProcessSet.insert(file);
+		}
+	}
+
+	//A file is parsed if any unit must regenerate it
+	std::vector<fs::path> filesToProcess(filesToProcessSet.cbegin(), filesToProcessSet.cend());
+
+	for (fs::path const& file : candidates)
 	{
-		genResult.completed = false;
+		if (filesToProcessSet.count(file) == 0u)
+		{
+			out_genResult.upToDateFiles.push_back(file);
+		}
 	}
-	else
+
+	//Discovery order depends on the tasks scheduling, sort files to get a deterministic result
+	std::sort(filesToProcess.begin(), filesToProcess.end());
+	std::sort(out_genResult.upToDateFiles.begin(), out_genResult.upToDateFiles.end());
+
+	//Don't setup anything if there are no files to generate
+	if (filesToProcess.size() > 0u)
 	{
-		//Start timer here
-		auto				start			= std::chrono::high_resolution_clock::now();
-		std::set<fs::path>	filesToProcess	= identifyFilesToProcess(codeGenUnit, genResult, forceRegenerateAll);
+		std::vector<std::vector<ProcessedFile>> processedFiles(units.size());
 
-		//Don't setup anything if there are no files to generate
-		if (filesToProcess.size() > 0u)
+		if (!inout_areParsingSettingsInitialized)
 		{
 			//Initialize the parsing settings to setup parser compilation arguments.
 			//parsingSettings can't be nullptr since it has been checked in the checkGenerationSetup call.
 			fileParser.getSettings().init(logger);
 
-			generateMacrosFile(fileParser.getSettings(), codeGenUnit.getSettings()->getOutputDirectory());
+			inout_areParsingSettingsInitialized = true;
+		}
+
+		std::vector<fs::path> outputDirectories;
+
+		for (size_t unitIndex = 0u; unitIndex < units.size(); unitIndex++)
+		{
+			std::vector<fs::path> const& unitFiles = unitFilesToProcess[unitIndex];
+
+			outputDirectories.emplace_back(units[unitIndex].codeGenUnit->getSettings()->getOutputDirectory());
+
+			if (!unitFiles.empty())
+			{
+				generateMacrosFile(fileParser.getSettings(), outputDirectories.back());
+			}
+
+			initProcessedFiles(filesToProcess, units[unitIndex].manifest, contentHashes, processedFiles[unitIndex]);
+
+			for (ProcessedFile& processedFile : processedFiles[unitIndex])
+			{
+				processedFile.shouldGenerate = std::binary_search(unitFiles.cbegin(), unitFiles.cend(), processedFile.path);
+			}
+		}
+
+		shareParsingDurations(processedFiles);
+
+		//Parser copies made to process files share the precompiled header
+		fileParser.preparePrecompiledHeader(filesToProcess, outputDirectories);
+
+		//Start files processing
+		if (shardCount == 0u)
+		{
+			processFiles(fileParser, units, filesToProcess, processedFiles, out_genResult);
+		}
+		else
+		{
+			processFilesInShards(fileParser, units, filesToProcess, contentHashes, shardCount, shardFileTimeout, out_genResult, processedFiles);
+		}
+
+		for (size_t unitIndex = 0u; unitIndex < units.size(); unitIndex++)
+		{
+			if (!unitFilesToProcess[unitIndex].empty())
+			{
+				fs::path outputDirectory = units[unitIndex].codeGenUnit->getSettings()->getOutputDirectory();
+
+				updateManifest(units[unitIndex].manifest, outputDirectory / CodeGenManifest::manifestFilename, fingerprints[unitIndex], outputDirectory, processedFiles[unitIndex], contentHashes);
+			}
+		}
+	}
+
+	//Units with nothing to regenerate still drop the entries of deleted sources
+	for (size_t unitIndex = 0u; unitIndex < units.size(); unitIndex++)
+	{
+		if (unitFilesToProcess[unitIndex].empty() && units[unitIndex].manifest.removeDeletedFiles() > 0u)
+		{
+			fs::path manifestFile = units[unitIndex].codeGenUnit->getSettings()->getOutputDirectory() / CodeGenManifest::manifestFilename;
+
+			if (!units[unitIndex].manifest.saveToFile(manifestFile) && logger != nullptr)
+			{
+				logger->log("Failed to save the generation manifest to " + manifestFile.string() + ".", ILogger::ELogSeverity::Warning);
+			}
+		}
+	}
+}
+
+template <typename FileParserType>
+void CodeGenManager::processFilesInShards(FileParserType& fileParser, std::vector<ProcessedUnit> const& units, std::vector<fs::path> const& toProcessFiles,
+										  std::unordered_map<fs::path, uint64, PathHash> const& contentHashes, uint32 shardCount, std::chrono::milliseconds fileTimeout,
+										  CodeGenResult& out_genResult, std::vector<std::vector<ProcessedFile>>& inout_processedFiles) noexcept
+{
+	std::unordered_map<fs::path, size_t, PathHash>	processedFileIndices;
+	std::vector<std::vector<bool>>					isReported(units.size(), std::vector<bool>(toProcessFiles.size(), false));
+	std::vector<bool>								isInReportedResult(toProcessFiles.size(), false);
+
+	//Only the forking thread exists in a forked process: a worker thread holding a lock (allocator, logger...) would keep it locked forever in the child.
+	//The workers are spawned again when tasks are queued once the shards are processed.
+	_threadPool.stopWorkers();
+
+	for (size_t i = 0u; i < toProcessFiles.size(); i++)
+	{
+		processedFileIndices.emplace(toProcessFiles[i], i);
+	}
+
+	//A file must be processed again as long as a unit generating it didn't report it
+	auto isFullyReported = [&inout_processedFiles, &isReported](size_t fileIndex)
+	{
+		for (size_t unitIndex = 0u; unitIndex < inout_processedFiles.size(); unitIndex++)
+		{
+			if (inout_processedFiles[unitIndex][fileIndex].shouldGenerate && !isReported[unitIndex][fileIndex])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	auto startWorker = [&](std::vector<size_t> const& fileIndices, std::vector<ShardWorker>& workers)
+	{
+		std::vector<fs::path> shardFiles;
+		shardFiles.reserve(fileIndices.size());
+
+		for (size_t fileIndex : fileIndices)
+		{
+			shardFiles.push_back(toProcessFiles[fileIndex]);
+		}
+
+		//The worker is forked from this process, so it processes its files with the current parser, generation units and manifests state
+		auto work = [&](int pipeDescriptor)
+		{
+			//The threads of this manager pool don't exist in the worker, so the worker uses its own single-threaded manager
+			CodeGenManager							shardManager(1u);
+			CodeGenResult							shardResult;
+			std::vector<std::vector<ProcessedFile>>	shardProcessedFiles(units.size());
+			std::mutex								pipeMutex;
+
+			shardManager.logger		= logger;
+			shardResult.completed	= true;
+
+			//Files already reported for a unit are not generated again for it
+			for (size_t unitIndex = 0u; unitIndex < units.size(); unitIndex++)
+			{
+				initProcessedFiles(shardFiles, units[unitIndex].manifest, contentHashes, shardProcessedFiles[unitIndex]);
+
+				for (size_t i = 0u; i < fileIndices.size(); i++)
+				{
+					shardProcessedFiles[unitIndex][i].shouldGenerate = inout_processedFiles[unitIndex][fileIndices[i]].shouldGenerate && !isReported[unitIndex][fileIndices[i]];
+				}
+			}
+
+			shardManager.processFiles(fileParser, units, shardFiles, shardProcessedFiles, shardResult,
+									  [&pipeMutex, pipeDescriptor](size_t unitIndex, ProcessedFile const& processedFile)
+									  {
+										  std::lock_guard<std::mutex> lock(pipeMutex);
+
+										  writeShardReport(pipeDescriptor, unitIndex, processedFile);
+									  });
+
+			writeShardResult(pipeDescriptor, shardResult);
+		};
+
+		ShardWorker worker;
+
+		//Files of a worker which could not start are retried like the files of a crashed worker
+		if (startShardWorker(work, worker))
+		{
+			worker.fileIndices = fileIndices;
+
+			workers.emplace_back(std::move(worker));
+		}
+	};
+
+	//Merge the results of the workers which processed all their files
+	auto mergeWorkerResults = [&out_genResult, &isInReportedResult](std::vector<ShardWorker>& workers)
+	{
+		for (ShardWorker& worker : workers)
+		{
+			if (worker.result.has_value())
+			{
+				out_genResult.mergeResult(std::move(*worker.result));
 
-			//Start files processing
-			processFiles(fileParser, codeGenUnit, filesToProcess, genResult);
+				for (size_t fileIndex : worker.fileIndices)
+				{
+					isInReportedResult[fileIndex] = true;
+				}
+			}
 		}
+	};
 
-		genResult.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count() * 0.001f;
+	std::vector<ShardWorker> workers;
+
+	for (std::vector<size_t> const& shard : makeShards(inout_processedFiles, shardCount))
+	{
+		startWorker(shard, workers);
+	}
+
+	//Files can't be retried if the workers can't be waited for, the run fails with their files unreported
+	bool canWaitWorkers = waitShardWorkers(workers, fileTimeout, processedFileIndices, inout_processedFiles, isReported);
+	mergeWorkerResults(workers);
+
+	out_genResult.completed &= canWaitWorkers;
+
+	//Retry the files which were not reported one by one, so that a file crashing or hanging its worker doesn't fail any other file
+	std::vector<size_t> toRetryFiles;
+
+	for (size_t i = 0u; i < toProcessFiles.size() && canWaitWorkers; i++)
+	{
+		if (!isFullyReported(i))
+		{
+			toRetryFiles.push_back(i);
+		}
+	}
+
+	for (size_t batchStart = 0u; batchStart < toRetryFiles.size(); batchStart += shardCount)
+	{
+		workers.clear();
+
+		for (size_t i = batchStart; i < toRetryFiles.size() && i < batchStart + shardCount; i++)
+		{
+			startWorker({ toRetryFiles[i] }, workers);
+		}
+
+		canWaitWorkers = waitShardWorkers(workers, fileTimeout, processedFileIndices, inout_processedFiles, isReported);
+		mergeWorkerResults(workers);
+
+		out_genResult.completed &= canWaitWorkers;
+
+		if (!canWaitWorkers)
+		{
+			break;
+		}
+	}
+
+	for (size_t i = 0u; i < toProcessFiles.size(); i++)
+	{
+		if (!isFullyReported(i) && logger != nullptr)
+		{
+			logger->log("Failed to process " + toProcessFiles[i].string() + ": its worker process crashed or hung.", ILogger::ELogSeverity::Error);
+		}
+
+		//A parsing shared by several units is counted by each of them. A file which crashed its worker has been parsed at least once.
+		uint8 parsingCount = 1u;
+
+		for (size_t unitIndex = 0u; unitIndex < units.size(); unitIndex++)
+		{
+			ProcessedFile& processedFile = inout_processedFiles[unitIndex][i];
+
+			if (processedFile.shouldGenerate)
+			{
+				if (!isReported[unitIndex][i])
+				{
+					processedFile.succeeded = false;
+				}
+
+				parsingCount			= std::max(parsingCount, processedFile.parsingCount);
+				out_genResult.completed	&= processedFile.succeeded;
+
+				//The result of the worker which processed the file already accounts for its processing duration
+				if (!isInReportedResult[i])
+				{
+					reportProcessingDuration(processedFile, out_genResult);
+				}
+			}
+		}
+
+		//The parsings of the files of a worker which crashed or hung are deduced from the file reports
+		if (!isInReportedResult[i])
+		{
+			for (uint8 j = 0u; j < parsingCount; j++)
+			{
+				out_genResult.parsedFiles.push_back(toProcessFiles[i]);
+			}
+		}
+	}
+
+	//Worker results are merged in their completion order, sort files to get a deterministic result
+	std::sort(out_genResult.parsedFiles.begin(), out_genResult.parsedFiles.end());
+}
+
+template <typename FileParserType>
+CodeGenResult CodeGenManager::runGeneration(FileParserType& fileParser, std::vector<ProcessedUnit>& units, bool forceRegenerateAll, bool& inout_areParsingSettingsInitialized,
+											uint32 shardCount, std::chrono::milliseconds shardFileTimeout) noexcept
+{
+	CodeGenResult genResult;
+	genResult.completed = true;
+
+	for (ProcessedUnit const& unit : units)
+	{
+		genResult.completed &= checkGenerationSetup(fileParser, *unit.codeGenUnit);
+	}
+
+	if (genResult.completed)
+	{
+		//Start timer here
+		auto start = std::chrono::high_resolution_clock::now();
+
+		//Load the manifests of the previous generation
+		std::unordered_set<fs::path, PathHash> candidates;
+
+		for (ProcessedUnit& unit : units)
+		{
+			unit.manifest.loadFromFile(unit.codeGenUnit->getSettings()->getOutputDirectory() / CodeGenManifest::manifestFilename);
+		}
+
+		_threadPool.resetStatistics();
+
+		discoverFiles(candidates);
+
+		generateFiles(fileParser, units, candidates, forceRegenerateAll, inout_areParsingSettingsInitialized, genResult, shardCount, shardFileTimeout);
+
+		genResult.threadPoolStatistics	= _threadPool.getStatistics();
+		genResult.duration				= std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count() * 0.001f;
 	}
 	
 	return genResult;
+}
+
+template <typename FileParserType, typename CodeGenUnitType>
+CodeGenResult CodeGenManager::run(FileParserType& fileParser, CodeGenUnitType& codeGenUnit, bool forceRegenerateAll) noexcept
+{
+	std::vector<ProcessedUnit>	units;
+	bool						areParsingSettingsInitialized = false;
+	units.emplace_back(makeProcessedUnit(codeGenUnit));
+
+	return runGeneration(fileParser, units, forceRegenerateAll, areParsingSettingsInitialized, 0u, std::chrono::milliseconds(0));
+}
+
+template <typename FileParserType, typename... CodeGenUnitTypes>
+CodeGenResult CodeGenManager::run(FileParserType& fileParser, std::tuple<CodeGenUnitTypes&...> codeGenUnits, bool forceRegenerateAll) noexcept
+{
+	static_assert(sizeof...(CodeGenUnitTypes) != 0u, "At least one CodeGenUnit must be provided.");
+
+	std::vector<ProcessedUnit>	units;
+	bool						areParsingSettingsInitialized = false;
+	units.reserve(sizeof...(CodeGenUnitTypes));
+
+	std::apply([&units](auto&... codeGenUnit)
+			   {
+				   (units.emplace_back(makeProcessedUnit(codeGenUnit)), ...);
+			   }, codeGenUnits);
+
+	return runGeneration(fileParser, units, forceRegenerateAll, areParsingSettingsInitialized, 0u, std::chrono::milliseconds(0));
+}
+
+template <typename FileParserType, typename CodeGenUnitType>
+CodeGenResult CodeGenManager::runSharded(FileParserType& fileParser, CodeGenUnitType& codeGenUnit, uint32 shardCount, bool forceRegenerateAll, std::chrono::milliseconds fileTimeout) noexcept
+{
+	std::vector<ProcessedUnit>	units;
+	bool						areParsingSettingsInitialized = false;
+	units.emplace_back(makeProcessedUnit(codeGenUnit));
+
+#if _WIN32
+	if (logger != nullptr)
+	{
+		logger->log("Sharded generation is not supported on this platform, files are processed in the current process.", ILogger::ELogSeverity::Warning);
+	}
+
+	return runGeneration(fileParser, units, forceRegenerateAll, areParsingSettingsInitialized, 0u, std::chrono::milliseconds(0));
+#else
+	return runGeneration(fileParser, units, forceRegenerateAll, areParsingSettingsInitialized, getThreadCount(shardCount), fileTimeout);
+#endif
+}
+
+template <typename FileParserType, typename CodeGenUnitType>
+bool CodeGenManager::watch(FileParserType& fileParser, CodeGenUnitType& codeGenUnit, std::function<void(CodeGenResult const&)> const& onGenerationCompleted) noexcept
+{
+	if (!checkGenerationSetup(fileParser, codeGenUnit))
+	{
+		return false;
+	}
+
+	std::error_code	error;
+	fs::path		outputDirectory = fs::weakly_canonical(codeGenUnit.getSettings()->getOutputDirectory(), error);
+
+	//Directories walked by the watcher, used to know which changed files are processed files
+	std::unordered_set<fs::path, PathHash>	processedDirectories;
+	std::unordered_set<fs::path, PathHash>	processedFiles;
+
+	//Directories of the files included by the processed files, only watched for their changes to regenerate the files including them
+	std::unordered_set<fs::path, PathHash>	dependencyDirectories;
+	std::vector<fs::path>					systemDirectories;
+
+	try
+	{
+		for (fs::path const& directory : CompilerHelpers::getCompilerNativeIncludeDirectories(fileParser.getSettings().getCompilerExeName()))
+		{
+			fs::path systemDirectory = FilesystemHelpers::sanitizePath(directory);
+
+			if (!systemDirectory.empty())
+			{
+				systemDirectories.emplace_back(std::move(systemDirectory));
+			}
+		}
+	}
+	catch (std::exception const&)
+	{
+		//The parsing settings initialization reports the error, system headers directories are then watched like any other
+	}
+
+	//Generated files are never processed, so the output directory is not watched to avoid triggering a generation after each generation
+	FileWatcher watcher([this, &processedDirectories, &outputDirectory](fs::path const& directory)
+						{
+							if (directory == outputDirectory || settings.isIgnoredDirectory(directory))
+							{
+								return false;
+							}
+
+							processedDirectories.insert(directory);
+
+							return true;
+						});
+
+	if (!watcher.isValid())
+	{
+		if (logger != nullptr)
+		{
+			logger->log("File watching is not supported on this platform.", ILogger::ELogSeverity::Error);
+		}
+
+		return false;
+	}
+
+	//The parsing settings, the manifest and the thread pool are kept alive between generations
+	std::vector<ProcessedUnit>	units;
+	bool						areParsingSettingsInitialized = false;
+
+	units.emplace_back(makeProcessedUnit(codeGenUnit));
+	units.front().manifest.loadFromFile(codeGenUnit.getSettings()->getOutputDirectory() / CodeGenManifest::manifestFilename);
+
+	//Generate all the files which changed since the last generation.
+	//Paths are watched before being discovered so that no change happening in the meantime is missed.
+	auto generateAll = [&]()
+	{
+		auto									start = std::chrono::high_resolution_clock::now();
+		CodeGenResult							genResult;
+		std::unordered_set<fs::path, PathHash>	candidates;
+
+		genResult.completed = true;
+
+		_threadPool.resetStatistics();
+
+		watchProcessedPaths(watcher, outputDirectory, processedDirectories, processedFiles);
+		discoverFiles(candidates);
+		generateFiles(fileParser, units, candidates, false, areParsingSettingsInitialized, genResult);
+		watchDependencyDirectories(watcher, units.front().manifest, outputDirectory, systemDirectories, dependencyDirectories);
+
+		genResult.threadPoolStatistics	= _threadPool.getStatistics();
+		genResult.duration				= std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count() * 0.001f;
+
+		return genResult;
+	};
+
+	CodeGenResult genResult = generateAll();
+
+	if (onGenerationCompleted)
+	{
+		onGenerationCompleted(genResult);
+	}
+
+	//Files change rarely compared to the generation time, don't keep idle workers alive meanwhile
+	setIdleWorkerTimeout(_watchIdleWorkerTimeout);
+
+	while (!_isStopWatchingRequested.load())
+	{
+		std::vector<fs::path>	changedFiles;
+		bool					missedChanges = false;
+
+		if (!watcher.waitForChanges(_watchPollingPeriod, changedFiles, missedChanges))
+		{
+			continue;
+		}
+
+		//Editors often save files in several steps: wait until no more change is detected so that all changes are processed together
+		while (watcher.waitForChanges(_watchSettleDelay, changedFiles, missedChanges))
+		{
+		}
+
+		if (missedChanges)
+		{
+			genResult = generateAll();
+		}
+		else
+		{
+			auto									start = std::chrono::high_resolution_clock::now();
+			std::unordered_set<fs::path, PathHash>	candidates;
+
+			collectChangedFiles(changedFiles, processedDirectories, processedFiles, units.front().manifest, candidates);
+
+			if (candidates.size() == 0u)
+			{
+				continue;
+			}
+
+			genResult			= CodeGenResult();
+			genResult.completed	= true;
+
+			_threadPool.resetStatistics();
+
+			generateFiles(fileParser, units, candidates, false, areParsingSettingsInitialized, genResult);
+			watchDependencyDirectories(watcher, units.front().manifest, outputDirectory, systemDirectories, dependencyDirectories);
+
+			genResult.threadPoolStatistics	= _threadPool.getStatistics();
+			genResult.duration				= std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count() * 0.001f;
+		}
+
+		if (onGenerationCompleted)
+		{
+			onGenerationCompleted(genResult);
+		}
+	}
+
+	setIdleWorkerTimeout(std::chrono::milliseconds(0));
+
+	_isStopWatchingRequested.store(false);
+
+	return true;
 }
\ No newline at end of file
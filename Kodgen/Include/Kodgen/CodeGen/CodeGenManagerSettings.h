@@ -262,6 +262,13 @@ namespace kodgen
 			*/
 			bool isIgnoredFile(fs::path const& file)							noexcept;
 
+			/**
+			*	@brief	Sanitize all ignored files and directories added since the last sanitization.
+			*			Until new ignored paths are added, isIgnoredFile and isIgnoredDirectory then don't modify the settings,
+			*			so they can safely be called from multiple threads, and getIgnoredFiles / getIgnoredDirectories only contain canonical paths.
+			*/
+			void sanitizeIgnoredPaths()											noexcept;
+
 			/**
 			*	@brief	Check whether the provided path is an ignored directory or not.
 			*			The method is not const to allow the path sanitizer to run if the _ignoredDirectoriesDirtyFlag is set.
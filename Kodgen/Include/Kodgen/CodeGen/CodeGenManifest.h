@@ -0,0 +1,161 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Persistent record of the state of each processed file at the time its code was last generated.
+	*	The manifest lives in the output directory of a CodeGenUnit and is used by the CodeGenManager
+	*	to decide which files must be regenerated, based on file contents rather than on file timestamps.
+	*	It also acts as the include dependency database: each entry records all the headers included by the
+	*	file when it was parsed, so that a change in any of them invalidates the file.
+	*/
+	class CodeGenManifest
+	{
+		public:
+			struct Dependency
+			{
+				/** Path to the included file. */
+				fs::path	path;
+
+				/** Hash of the included file content when the code of the including file was last generated. */
+				uint64		contentHash	= 0u;
+			};
+
+			struct Entry
+			{
+				/** Hash of the source file content when its code was last generated. */
+				uint64					contentHash		= 0u;
+
+				/** Fingerprint of the parsing settings, generation settings and modules used to generate the code. */
+				uint64					fingerprint		= 0u;
+
+				/** Time spent (in microseconds) to parse the source file during its last generation. */
+				uint32					parsingDuration		= 0u;
+
+				/** Time spent (in microseconds) to generate the code of the source file during its last generation. */
+				uint32					generationDuration	= 0u;
+
+				/** All files included by the source file when its code was last generated. */
+				std::vector<Dependency>	dependencies;
+			};
+
+		private:
+			/** Version of the manifest file format. Manifests with a different version are discarded. */
+			static constexpr uint32 const				_formatVersion	= 3u;
+
+			/** Header written at the beginning of each manifest file. */
+			static constexpr char const*				_fileHeader		= "KodgenManifest";
+
+			/** Entry of each file, indexed by file path. */
+			std::unordered_map<fs::path, Entry, PathHash>	_entries;
+
+		public:
+			/** Name of the manifest file generated in the output directory. */
+			static inline fs::path const manifestFilename = "KodgenManifest.txt";
+
+			/**
+			*	@brief	Load the manifest from a file, replacing the current content of this manifest.
+			*			If the file doesn't exist or has an incompatible format, the manifest is left empty.
+			*
+			*	@param manifestFile Path to the manifest file.
+			*
+			*	@return true if the manifest could be loaded, else false.
+			*/
+			bool			loadFromFile(fs::path const& manifestFile)					noexcept;
+
+			/**
+			*	@brief	Save the manifest to a file.
+			*			The content is first written to a temporary file which then replaces the manifest file,
+			*			so that an interrupted save never leaves a truncated manifest behind.
+			*
+			*	@param manifestFile Path to the manifest file.
+			*
+			*	@return true if the manifest could be saved, else false.
+			*/
+			bool			saveToFile(fs::path const& manifestFile)			const	noexcept;
+
+			/**
+			*	@brief	Check whether the code generated for a file is still valid, i.e. the file entry matches the provided fingerprint,
+			*			and neither the file nor any of its dependencies changed since the last generation.
+			*
+			*	@param file				Path to the source file.
+			*	@param fingerprint		Fingerprint of the current generation setup.
+			*	@param contentHashes	Current content hash of the source file and of all its recorded dependencies.
+			*							A file missing from this map is considered modified.
+			*
+			*	@return true if the code generated for the file is still valid, else false.
+			*/
+			bool			isUpToDate(fs::path const&										file,
+									   uint64												fingerprint,
+									   std::unordered_map<fs::path, uint64, PathHash> const&	contentHashes)	const	noexcept;
+
+			/**
+			*	@brief Get the entry of a file.
+			*
+			*	@param file Path to the source file.
+			*
+			*	@return A pointer to the file entry if any, else nullptr.
+			*/
+			Entry const*	getEntry(fs::path const& file)						const	noexcept;
+
+			/**
+			*	@brief Collect all the files which recorded a dependency on any of the provided files.
+			*
+			*	@param files				Paths to the included files.
+			*	@param out_dependentFiles	Set filled with the path of each file including any of the provided files.
+			*/
+			void			getDependentFiles(std::unordered_set<fs::path, PathHash> const&	files,
+											  std::unordered_set<fs::path, PathHash>&		out_dependentFiles)	const	noexcept;
+
+			/**
+			*	@brief Collect all the files recorded as a dependency of any source file.
+			*
+			*	@param out_dependencies Set filled with the path of each included file.
+			*/
+			void			getDependencies(std::unordered_set<fs::path, PathHash>& out_dependencies)	const	noexcept;
+
+			/**
+			*	@brief Add or replace the entry of a file.
+			*
+			*	@param file		Path to the source file.
+			*	@param entry	New entry of the file.
+			*/
+			void			updateEntry(fs::path const&	file,
+										Entry const&	entry)							noexcept;
+
+			/**
+			*	@brief Remove the entry of a file, so that it is considered outdated by the next generation.
+			*
+			*	@param file Path to the source file.
+			*
+			*	@return true if an entry has been removed, else false.
+			*/
+			bool			removeEntry(fs::path const& file)							noexcept;
+
+			/**
+			*	@brief Remove the entries of the source files which don't exist anymore, so that deleted files don't stay in the manifest forever.
+			*
+			*	@return The number of removed entries.
+			*/
+			size_t			removeDeletedFiles()										noexcept;
+
+			/**
+			*	@brief Remove all entries from the manifest.
+			*/
+			void			clear()														noexcept;
+	};
+}
\ No newline at end of file
@@ -94,6 +94,22 @@ namespace kodgen
 			*/
 			virtual int32							getGenerationOrder()							const	noexcept override;
 
+			/**
+			*	@return The fingerprint of this module combined with the fingerprints of all its property code generators.
+			*/
+			virtual uint64							computeFingerprint()							const	noexcept override;
+
+			/**
+			*	@return true if this module or any of its property code generators requires files to be reparsed between iterations, else false.
+			*/
+			virtual bool							shouldReparseBetweenIterations()				const	noexcept override;
+
+			/**
+			*	@brief	Reset the generation state of all the registered property code generators.
+			*			/!\ Overrides MUST call this base implementation as well through CodeGenModule::resetGenerationState() /!\
+			*/
+			virtual void							resetGenerationState()									noexcept override;
+
 			/**
 			*	@brief Getter for _propertyCodeGenerators field.
 			*
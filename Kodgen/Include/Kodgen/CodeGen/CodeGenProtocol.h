@@ -0,0 +1,113 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+
+#include "Kodgen/Misc/FundamentalTypes.h"
+#include "Kodgen/Misc/LocalSocket.h"
+#include "Kodgen/CodeGen/CodeGenRequest.h"
+#include "Kodgen/CodeGen/CodeGenResult.h"
+
+namespace kodgen
+{
+	/**
+	*	Messages exchanged between a CodeGenServer and its clients.
+	*	A message is a header line followed by one "<key> <value>" line per field and an "end" line.
+	*	Paths are written as is since they are always the last element of their line.
+	*/
+	class CodeGenProtocol
+	{
+		private:
+			/** Version of the protocol. Messages with a different version are rejected. */
+			static constexpr uint32 const	_version		= 1u;
+
+			/** Header line of a request. */
+			static constexpr char const*	_requestHeader	= "KodgenRequest";
+
+			/** Header line of a result. */
+			static constexpr char const*	_resultHeader	= "KodgenResult";
+
+			/** Line ending a message. */
+			static constexpr char const*	_messageEnd		= "end";
+
+			/**
+			*	@brief Receive the header of a message and check that it matches the expected header and protocol version.
+			*
+			*	@param socket	Socket to receive the header from.
+			*	@param header	Expected header.
+			*
+			*	@return true if the expected header has been received, else false.
+			*/
+			static bool	receiveHeader(LocalSocket&	socket,
+									  char const*	header)			noexcept;
+
+			/**
+			*	@brief Receive the next field of a message.
+			*
+			*	@param socket			Socket to receive the field from.
+			*	@param out_key			Key of the field.
+			*	@param out_value		Value of the field.
+			*	@param out_isMessageEnd	Set to true if the end of the message has been received instead of a field.
+			*
+			*	@return true if a line has been received, false if the connection has been closed.
+			*/
+			static bool	receiveField(LocalSocket&	socket,
+									 std::string&	out_key,
+									 std::string&	out_value,
+									 bool&			out_isMessageEnd)	noexcept;
+
+		public:
+			CodeGenProtocol()	= delete;
+			~CodeGenProtocol()	= delete;
+
+			/**
+			*	@brief Send a request through a connected socket. Relative paths of the request are made absolute first.
+			*
+			*	@param socket	Socket to send the request through.
+			*	@param request	The request to send.
+			*
+			*	@return true if the request has been sent, else false.
+			*/
+			static bool sendRequest(LocalSocket&			socket,
+									CodeGenRequest const&	request)			noexcept;
+
+			/**
+			*	@brief Receive a request through a connected socket.
+			*
+			*	@param socket		Socket to receive the request from.
+			*	@param out_request	The received request.
+			*
+			*	@return true if a valid request has been received, else false. Requests containing relative paths are invalid.
+			*/
+			static bool receiveRequest(LocalSocket&		socket,
+									   CodeGenRequest&	out_request)			noexcept;
+
+			/**
+			*	@brief Send a generation result through a connected socket.
+			*
+			*	@param socket		Socket to send the result through.
+			*	@param genResult	The result to send.
+			*
+			*	@return true if the result has been sent, else false.
+			*/
+			static bool sendResult(LocalSocket&			socket,
+								   CodeGenResult const&	genResult)				noexcept;
+
+			/**
+			*	@brief Receive a generation result through a connected socket.
+			*
+			*	@param socket			Socket to receive the result from.
+			*	@param out_genResult	The received result.
+			*
+			*	@return true if a valid result has been received, else false.
+			*/
+			static bool receiveResult(LocalSocket&		socket,
+									  CodeGenResult&	out_genResult)			noexcept;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "Kodgen/Misc/Filesystem.h"
+
+namespace kodgen
+{
+	/**
+	*	Generation requested to a CodeGenServer.
+	*	Paths are sent absolute, resolved against the working directory of the client (see CodeGenProtocol::sendRequest).
+	*/
+	struct CodeGenRequest
+	{
+		/**
+		*	Files to process. If any file or directory to process is specified, they replace the files and directories
+		*	to process of the server settings for this request, otherwise the server settings are used as is.
+		*/
+		std::vector<fs::path>	toProcessFiles;
+
+		/** Directories to process. See toProcessFiles. */
+		std::vector<fs::path>	toProcessDirectories;
+
+		/** Files to ignore, in addition to the files ignored by the server settings. */
+		std::vector<fs::path>	ignoredFiles;
+
+		/** Directories to ignore, in addition to the directories ignored by the server settings. */
+		std::vector<fs::path>	ignoredDirectories;
+
+		/** Should all files be regenerated regardless of the manifest content? */
+		bool					forceRegenerateAll	= false;
+	};
+}
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Threading/ThreadPoolStatistics.h"
 
 namespace kodgen
 {
@@ -31,6 +32,29 @@ namespace kodgen
 			/** List of paths to files which metadata are up-to-date. */
 			std::vector<fs::path>	upToDateFiles;
 
+			/**
+			*	Sum of the processing (parsing + generation) durations (in seconds) predicted for the processed files.
+			*	Predictions are based on the durations measured during previous generations, or on file sizes for files without history.
+			*	Files processed when no history at all is available are not predicted and are not accounted in any of the prediction fields.
+			*/
+			float					predictedProcessingDuration			= 0.0f;
+
+			/** Sum of the processing durations (in seconds) measured for the files accounted in predictedProcessingDuration. */
+			float					measuredProcessingDuration			= 0.0f;
+
+			/**
+			*	Sum of the absolute differences (in seconds) between the predicted and measured processing duration of each file
+			*	accounted in predictedProcessingDuration. Divide it by measuredProcessingDuration to get the relative prediction error.
+			*/
+			float					processingDurationPredictionError	= 0.0f;
+
+			/**
+			*	Activity of the thread pool of the CodeGenManager during the generation, to tell whether files processing was limited by
+			*	the tasks themselves, by the workers competing for the queues or by tasks waiting for their dependencies.
+			*	Files processed by the worker processes of a sharded generation are not accounted. It is not merged by mergeResult.
+			*/
+			ThreadPoolStatistics	threadPoolStatistics;
+
 			/**
 			*	@brief Merge a result to this result.
 			*	
@@ -0,0 +1,96 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>	//std::chrono::milliseconds
+
+#include "Kodgen/Misc/ILogger.h"
+#include "Kodgen/Misc/LocalSocket.h"
+#include "Kodgen/CodeGen/CodeGenManager.h"
+#include "Kodgen/CodeGen/CodeGenRequest.h"
+#include "Kodgen/CodeGen/CodeGenProtocol.h"
+
+namespace kodgen
+{
+	/**
+	*	Long running front-end of a CodeGenManager, serving generation requests received on a local socket.
+	*	Build systems can then send a request per target through a thin client (see CodeGenProtocol) instead of starting
+	*	a new generator process each time, so that the thread pool, the compiler include directories probed by the parser settings
+	*	and the system file caches are reused by all requests.
+	*/
+	class CodeGenServer
+	{
+		private:
+			/** Maximum time spent waiting for a connection before checking whether the server should stop. */
+			static constexpr std::chrono::milliseconds const	_acceptPollingPeriod	= std::chrono::milliseconds(100);
+
+			/** Time after which idle worker threads of the served manager exit between requests. */
+			static constexpr std::chrono::milliseconds const	_idleWorkerTimeout		= std::chrono::seconds(10);
+
+			/** Socket listening to the clients connections. */
+			LocalSocket											_socket;
+
+			/** Has stop been called since the last serve call returned? */
+			std::atomic_bool									_isStopRequested		= false;
+
+			/**
+			*	@brief Apply the settings overrides of a request to the settings of a code generation manager.
+			*
+			*	@param request			The request to apply.
+			*	@param inout_settings	Settings to modify.
+			*/
+			static void	applyRequest(CodeGenRequest const&		request,
+									 CodeGenManagerSettings&	inout_settings)	noexcept;
+
+		public:
+			/** Logger used to issue logs from the CodeGenServer. */
+			ILogger*					logger					= nullptr;
+
+			/** Maximum time to wait for each line of a request or for sending the result, after which the client is dropped. */
+			std::chrono::milliseconds	clientTimeout			= std::chrono::seconds(5);
+
+			/** Maximum length of a request line, after which the client is dropped. */
+			size_t						maxRequestLineLength	= 64u * 1024u;
+
+			/**
+			*	@brief Start listening to clients connections.
+			*
+			*	@param socketPath Path of the local socket the clients connect to.
+			*
+			*	@return true if the server listens, else false.
+			*/
+			bool	start(fs::path const& socketPath)	noexcept;
+
+			/**
+			*	@brief	Serve generation requests until stop is called. Requests are processed one after the other:
+			*			for each request, the code generation manager runs with its settings modified as requested,
+			*			then the generation result is sent back to the client. A client which stalls or sends a too long
+			*			line is dropped, so that it can't block the other clients or the stop call. The parsing settings of the file parser are
+			*			initialized once, by the first request parsing a file, so they must not change while serving.
+			*
+			*	@param codeGenManager	Code generation manager processing the requests. Its settings are restored after each request.
+			*	@param fileParser		Original file parser to use to parse files. Its settings are initialized once for all the requests.
+			*	@param codeGenUnit		Generation unit used to generate code. It must have a clean state when this method is called.
+			*
+			*	@return false if the server has not been started, else true once the server stopped.
+			*/
+			template <typename FileParserType, typename CodeGenUnitType>
+			bool	serve(CodeGenManager&	codeGenManager,
+						  FileParserType&	fileParser,
+						  CodeGenUnitType&	codeGenUnit)		noexcept;
+
+			/**
+			*	@brief	Make the running serve call return once the ongoing request, if any, has been processed.
+			*			This method can be called from any thread.
+			*/
+			void	stop()								noexcept;
+	};
+
+	#include "Kodgen/CodeGen/CodeGenServer.inl"
+}
\ No newline at end of file
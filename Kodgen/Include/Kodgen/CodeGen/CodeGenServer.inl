@@ -0,0 +1,71 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+template <typename FileParserType, typename CodeGenUnitType>
+bool CodeGenServer::serve(CodeGenManager& codeGenManager, FileParserType& fileParser, CodeGenUnitType& codeGenUnit) noexcept
+{
+	if (!_socket.isValid())
+	{
+		if (logger != nullptr)
+		{
+			logger->log("The server must be started before serving requests.", ILogger::ELogSeverity::Error);
+		}
+
+		return false;
+	}
+
+	//Requests may be far apart, don't keep idle workers alive meanwhile
+	codeGenManager.setIdleWorkerTimeout(_idleWorkerTimeout);
+
+	//The parsing settings are initialized by the first request parsing a file, and kept for the following requests
+	std::vector<CodeGenManager::ProcessedUnit>	units;
+	bool										areParsingSettingsInitialized = false;
+
+	units.emplace_back(CodeGenManager::makeProcessedUnit(codeGenUnit));
+
+	while (!_isStopRequested.load())
+	{
+		LocalSocket client;
+
+		if (!_socket.accept(_acceptPollingPeriod, client))
+		{
+			continue;
+		}
+
+		CodeGenRequest	request;
+		CodeGenResult	genResult;
+
+		client.setLimits(clientTimeout, maxRequestLineLength);
+
+		if (CodeGenProtocol::receiveRequest(client, request))
+		{
+			CodeGenManagerSettings serverSettings = codeGenManager.settings;
+
+			applyRequest(request, codeGenManager.settings);
+
+			genResult = codeGenManager.runGeneration(fileParser, units, request.forceRegenerateAll, areParsingSettingsInitialized, 0u, std::chrono::milliseconds(0));
+
+			codeGenManager.settings = std::move(serverSettings);
+		}
+		else if (logger != nullptr)
+		{
+			logger->log("Received an invalid generation request, or the client stalled.", ILogger::ELogSeverity::Warning);
+		}
+
+		//Always answer so that the client doesn't wait forever, genResult.completed is false if the request was invalid
+		if (!CodeGenProtocol::sendResult(client, genResult) && logger != nullptr)
+		{
+			logger->log("Could not send the generation result to the client.", ILogger::ELogSeverity::Warning);
+		}
+	}
+
+	codeGenManager.setIdleWorkerTimeout(std::chrono::milliseconds(0));
+
+	_isStopRequested.store(false);
+
+	return true;
+}
\ No newline at end of file
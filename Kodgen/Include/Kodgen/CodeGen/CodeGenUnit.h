@@ -264,7 +264,9 @@ namespace kodgen
 			virtual ~CodeGenUnit()			noexcept;
 
 			/**
-			*	@brief Check whether the generated code for a given source file is up-to-date or not.
+			*	@brief	Check whether the generated code for a given source file is up-to-date or not.
+			*			The CodeGenManager already tracks the source file content and the generation fingerprint
+			*			in its manifest, so implementations only have to check the presence of generated outputs.
 			* 
 			*	@param sourceFile Path to the source file.
 			*
@@ -323,6 +325,46 @@ namespace kodgen
 			*/
 			uint8								getIterationCount()						const	noexcept;
 
+			/**
+			*	@brief	Check whether any registered module requires files to be reparsed between code generation iterations.
+			* 
+			*	@return true if files must be reparsed between iterations, else false.
+			*/
+			bool								shouldReparseBetweenIterations()		const	noexcept;
+
+			/**
+			*	@brief	Compute a fingerprint of the settings and of all registered modules of this unit.
+			*			The generated code of a file must be regenerated whenever the fingerprint used to generate it changes.
+			* 
+			*	@return The fingerprint of this unit.
+			*/
+			virtual uint64						computeFingerprint()					const	noexcept;
+
+			/**
+			*	@brief	Reset the generation state of this unit and of all its registered modules.
+			*			When the unit is reusable (see isReusable), the CodeGenManager copies it once per generation thread, and calls
+			*			this method on the copy before it generates each file but the first one, instead of copying the unit
+			*			(and cloning all its modules) for each file.
+			*			/!\ Overrides MUST call this base implementation as well through CodeGenUnit::resetGenerationState() /!\
+			*/
+			virtual void						resetGenerationState()							noexcept;
+
+			/**
+			*	@brief	Check whether resetGenerationState clears all the state accumulated by this unit while generating a file.
+			*			Units overriding this method to return true must still check the generators they hold through isReusable.
+			* 
+			*	@return true if this unit can generate several files in sequence, else false. Default is false.
+			*/
+			virtual bool						supportsReuse()							const	noexcept;
+
+			/**
+			*	@brief	Check whether this unit, all its registered modules and all their property code generators support reuse.
+			*			The CodeGenManager copies the unit for each generated file when this method returns false.
+			* 
+			*	@return true if a single copy of this unit can generate several files in sequence, else false.
+			*/
+			bool								isReusable()							const	noexcept;
+
 			/**
 			*	@brief Getter for _generationModules field.
 			* 
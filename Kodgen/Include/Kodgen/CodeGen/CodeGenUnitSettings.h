@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Kodgen/Misc/Settings.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
 
 namespace kodgen
 {
@@ -65,5 +66,14 @@ namespace kodgen
 			*	@return _outputDirectory.
 			*/
 			fs::path const&	getOutputDirectory()						const	noexcept;
+
+			/**
+			*	@brief	Compute a fingerprint of the settings affecting the generated code.
+			*			Child classes adding new settings should override this method and combine
+			*			their own settings with the base implementation result.
+			* 
+			*	@return The fingerprint of these settings.
+			*/
+			virtual uint64	computeFingerprint()						const	noexcept;
 	};
 }
\ No newline at end of file
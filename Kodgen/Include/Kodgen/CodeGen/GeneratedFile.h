@@ -8,7 +8,6 @@
 #pragma once
 
 #include <string>
-#include <fstream>
 
 #include "Kodgen/Misc/Filesystem.h"
 
@@ -17,9 +16,14 @@ namespace kodgen
 	class GeneratedFile
 	{
 		private:
-			fs::path		_path;
-			fs::path		_sourceFilePath;
-			std::ofstream	_streamToFile;
+			fs::path	_path;
+			fs::path	_sourceFilePath;
+
+			/**
+			*	Content of the generated file, written to the disk when the GeneratedFile is destroyed.
+			*	An existing file with the same content is left untouched, so that its last write time only changes with its content.
+			*/
+			std::string	_content;
 
 			/**
 			*	@brief Write a single line in the generated file
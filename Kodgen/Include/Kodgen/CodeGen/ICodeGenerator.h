@@ -106,6 +106,42 @@ namespace kodgen
 			*/
 			virtual uint8				getIterationCount()															const	noexcept;
 
+			/**
+			*	@brief	Should a file be parsed again before each code generation iteration following the first one?
+			*			By default, the parsing result of the first iteration is reused by all subsequent iterations
+			*			since parsing is by far the most expensive part of the generation.
+			*			Override it to return true if this generator relies on entities declared in code generated by a previous iteration.
+			* 
+			*	@return true if files must be reparsed between iterations, else false. Default is false.
+			*/
+			virtual bool				shouldReparseBetweenIterations()											const	noexcept;
+
+			/**
+			*	@brief	Compute a fingerprint identifying this code generator and its configuration.
+			*			A change of fingerprint invalidates all the code previously generated with this code generator.
+			*			The default implementation combines the dynamic type (if RTTI is enabled), the generation order and the iteration count.
+			*			Override it to add any user configuration affecting the generated code.
+			* 
+			*	@return The fingerprint of this code generator.
+			*/
+			virtual uint64				computeFingerprint()														const	noexcept;
+
+			/**
+			*	@brief	Called before each file generation of a unit instance which already generated code for another file.
+			*			This only happens when the unit and all its generators support reuse (see supportsReuse).
+			*			Does nothing by default.
+			*/
+			virtual void				resetGenerationState()																noexcept;
+
+			/**
+			*	@brief	Check whether resetGenerationState clears all the state accumulated by this generator while generating a file.
+			*			When the unit and all its generators support reuse, a unit instance is copied once per generation thread and reused
+			*			for all the files generated by that thread. Otherwise, the unit is copied for each generated file.
+			* 
+			*	@return true if this generator can generate several files in sequence, else false. Default is false.
+			*/
+			virtual bool				supportsReuse()																const	noexcept;
+
 			ICodeGenerator& operator=(ICodeGenerator const&)	= default;
 			ICodeGenerator& operator=(ICodeGenerator&&)			= default;
 	};
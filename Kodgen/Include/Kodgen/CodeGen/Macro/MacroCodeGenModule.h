@@ -120,6 +120,8 @@ namespace kodgen
 			/**
 			*	@brief	Macro module needs to run at least 2 times to work properly since generated files / macros
 			*			might not exist during the first parsing pass.
+			*			Files whose first parsing pass failed to compile because of such missing macros are reparsed
+			*			by the CodeGenManager before the next iteration.
 			* 
 			*	@return 2.
 			*/
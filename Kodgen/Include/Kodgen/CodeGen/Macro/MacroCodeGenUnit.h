@@ -151,7 +151,8 @@ namespace kodgen
 
 		public:
 			/**
-			*	@brief	Check that both the generated header and source files are newer than the source file.
+			*	@brief	Check that both the generated header and source files exist.
+			*			Whether their content matches the source file is tracked by the CodeGenManager manifest.
 			*			If the generated header file doesn't exist, create it and leave it empty.
 			*			We do that because since the generated header is included in the source code,
 			*			it could generate an undefined behaviour if the header doesn't exist.
@@ -162,6 +163,13 @@ namespace kodgen
 			*/
 			virtual bool					isUpToDate(fs::path const& sourceFile)				const	noexcept	override;
 
+			/**
+			*	@brief	The generated code buffers are cleared before each file generation in preGenerateCode.
+			* 
+			*	@return true.
+			*/
+			virtual bool					supportsReuse()										const	noexcept	override;
+
 			/**
 			*	@brief	Add a module to the internal list of generation modules.
 			*			This method is a more restrictive replacement for the CodeGenUnit::addModule(CodeGenModule&) method.
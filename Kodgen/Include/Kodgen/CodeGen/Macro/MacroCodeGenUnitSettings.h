@@ -279,5 +279,12 @@ namespace kodgen
 			*	@return _internalSymbolMacroName.
 			*/
 			std::string const&	getInternalSymbolMacroName()	const	noexcept;
+
+			/**
+			*	@brief Compute a fingerprint of the settings affecting the generated code, including all macro and file name patterns.
+			* 
+			*	@return The fingerprint of these settings.
+			*/
+			virtual uint64		computeFingerprint()			const	noexcept	override;
 	};
 }
\ No newline at end of file
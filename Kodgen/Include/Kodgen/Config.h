@@ -40,6 +40,11 @@
 
 #endif
 
+//Set macro if C++20 coroutines are available, which requires to compile as C++20
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define KODGEN_COROUTINES_ENABLED
+#endif
+
 #define KODGEN_VERSION_MAJOR 2
 #define KODGEN_VERSION_MINOR 2
 #define KODGEN_VERSION_PATCH 0
\ No newline at end of file
@@ -11,6 +11,8 @@
 #include <string>
 #include <array>
 #include <string_view>
+#include <mutex>
+#include <unordered_map>
 
 #include "Kodgen/Misc/Filesystem.h"
 
@@ -25,6 +27,23 @@ namespace kodgen
 			static constexpr std::string_view gccCompilerName	= "gcc";
 			static constexpr std::string_view gccCompilerName2	= "g++";
 
+			/** Mutex protecting _nativeIncludeDirectories. */
+			static inline std::mutex												_nativeIncludeDirectoriesMutex;
+
+			/** Native include directories already retrieved, indexed by normalized compiler executable name. */
+			static inline std::unordered_map<std::string, std::vector<fs::path>>	_nativeIncludeDirectories;
+
+			/**
+			*	@brief Query all native include directories of a given compiler on the executing computer.
+			*
+			*	@param normalizedCompilerExeName Normalized name of the compiler executable.
+			*	
+			*	@return A vector containing all native include directories for the provided compiler.
+			*
+			*	@exception std::runtime_error is thrown if the compiler has a valid name but include directories could not be queried on the executing computer.
+			*/
+			static std::vector<fs::path> queryCompilerNativeIncludeDirectories(std::string const& normalizedCompilerExeName);
+
 			/**
 			*	@brief Retrieve all clang native include directories on the executing computer.
 			*
@@ -110,7 +129,8 @@ namespace kodgen
 			static bool						isGCC(std::string const& normalizedCompilerExeName)					noexcept;
 
 			/**
-			*	@brief Retrieve all native include directories of a given compiler on the executing computer.
+			*	@brief	Retrieve all native include directories of a given compiler on the executing computer.
+			*			Directories are queried by running the compiler the first time only, and reused by later calls for the same compiler.
 			*
 			*	@param compiler Compiler we are looking the include directories of.
 			*	
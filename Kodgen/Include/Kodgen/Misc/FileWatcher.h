@@ -0,0 +1,109 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <chrono>		//std::chrono::milliseconds
+#include <functional>	//std::function
+
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Report the files created, modified, moved or deleted in a set of directories.
+	*	Changes are detected with inotify, so the watcher is only supported on Linux: on other platforms, isValid always returns false.
+	*/
+	class FileWatcher
+	{
+		public:
+			/** Predicate called for each directory found in a recursively watched directory. The directory is watched only if it returns true. */
+			using DirectoryFilter = std::function<bool(fs::path const&)>;
+
+		private:
+			struct WatchedDirectory
+			{
+				/** Path to the directory. */
+				fs::path	path;
+
+				/** Are the subdirectories of this directory watched as well? */
+				bool		isRecursive	= false;
+			};
+
+			/** Size of the buffer events are read into. */
+			static constexpr size_t const					_eventBufferSize	= 64u * 1024u;
+
+			/** Inotify instance file descriptor, -1 if the watcher is not valid. */
+			int												_inotifyDescriptor	= -1;
+
+			/** Predicate deciding which subdirectories of a recursively watched directory are watched. */
+			DirectoryFilter									_directoryFilter;
+
+			/** Watched directories, indexed by their inotify watch descriptor. */
+			std::unordered_map<int, WatchedDirectory>		_watchedDirectories;
+
+			/**
+			*	@brief Watch a directory and, if isRecursive is true, all its subdirectories accepted by the directory filter.
+			*
+			*	@param directory			The directory to watch.
+			*	@param isRecursive			Should the subdirectories be watched as well?
+			*	@param out_existingFiles	If not nullptr, vector the files already contained in the watched directories are appended to.
+			*
+			*	@return true if the directory is watched, else false.
+			*/
+			bool	addWatch(fs::path const&			directory,
+							 bool						isRecursive,
+							 std::vector<fs::path>*		out_existingFiles)	noexcept;
+
+		public:
+			/**
+			*	@param directoryFilter	Predicate deciding which subdirectories of a recursively watched directory are watched.
+			*							All subdirectories are watched if it is empty.
+			*/
+			FileWatcher(DirectoryFilter directoryFilter = nullptr)	noexcept;
+			FileWatcher(FileWatcher const&)							= delete;
+			FileWatcher(FileWatcher&&)								= delete;
+			~FileWatcher()											noexcept;
+
+			/**
+			*	@brief Check whether the watcher could be initialized.
+			*
+			*	@return true if the watcher can be used, else false.
+			*/
+			bool	isValid()																		const	noexcept;
+
+			/**
+			*	@brief	Start watching a directory. Only the direct entries of the directory are watched, unless isRecursive is true,
+			*			in which case all its subdirectories accepted by the directory filter are watched as well, including the ones created later.
+			*
+			*	@param directory	The directory to watch. It should be a canonical path, since reported paths are built from it.
+			*	@param isRecursive	Should the subdirectories be watched as well?
+			*
+			*	@return true if the directory is watched, else false.
+			*/
+			bool	watchDirectory(fs::path const&	directory,
+								   bool				isRecursive)											noexcept;
+
+			/**
+			*	@brief	Wait until some files changed in the watched directories, or until the timeout expires.
+			*			A file changed several times might be reported several times.
+			*			Files contained in a directory created or moved in a recursively watched directory are reported as well.
+			*
+			*	@param timeout				Maximum time to wait for changes.
+			*	@param out_changedFiles		Vector the path of each created, modified, moved or deleted file is appended to.
+			*	@param out_missedChanges	Set to true if the kernel event queue overflowed: some changes were lost, so all files must be considered modified.
+			*
+			*	@return true if any change has been detected, else false.
+			*/
+			bool	waitForChanges(std::chrono::milliseconds	timeout,
+								   std::vector<fs::path>&		out_changedFiles,
+								   bool&						out_missedChanges)						noexcept;
+	};
+}
\ No newline at end of file
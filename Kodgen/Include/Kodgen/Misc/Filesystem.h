@@ -17,10 +17,28 @@
 	#error "No filesystem support"
 #endif
 
+#include <string>
+#include <vector>
 #include <functional>
 
 namespace kodgen
 {
+	/** Entry of a directory, as returned by FilesystemHelpers::readDirectory. */
+	struct DirectoryEntry
+	{
+		/** Name of the entry (not the full path). */
+		std::string	name;
+
+		/** Is the entry a directory (symlinks are followed)? */
+		bool		isDirectory		= false;
+
+		/** Is the entry a regular file (symlinks are followed)? */
+		bool		isRegularFile	= false;
+
+		/** Is the entry a symbolic link? */
+		bool		isSymlink		= false;
+	};
+
 	struct PathHash
 	{
 		size_t operator()(fs::path const& path) const noexcept
@@ -64,5 +82,18 @@ namespace kodgen
 			*/
 			static bool		isChildPath(fs::path const& child,
 										fs::path const& other)			noexcept;
+
+			/**
+			*	@brief	List the entries of a directory, without the "." and ".." entries.
+			*			On Unix systems, the entry type is read from the directory listing itself (dirent::d_type)
+			*			so that no extra system call is required, except for symbolic links and filesystems not reporting types.
+			*
+			*	@param directory	The directory to read.
+			*	@param out_entries	Vector the directory entries are appended to.
+			*	
+			*	@return true if the directory could be read, else false.
+			*/
+			static bool		readDirectory(fs::path const&				directory,
+										  std::vector<DirectoryEntry>&	out_entries)	noexcept;
 	};
 }
\ No newline at end of file
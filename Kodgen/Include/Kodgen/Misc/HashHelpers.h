@@ -0,0 +1,72 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <cstddef>	//size_t
+
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/Optional.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	class HashHelpers
+	{
+		public:
+			/** Initial value of a hash (FNV-1a 64 bits offset basis). */
+			static constexpr uint64 const	initialHash = 14695981039346656037ull;
+
+			HashHelpers()	= delete;
+			~HashHelpers()	= delete;
+
+			/**
+			*	@brief Hash a sequence of bytes (FNV-1a 64 bits).
+			*
+			*	@param data	Pointer to the first byte to hash.
+			*	@param size	Number of bytes to hash.
+			*	@param seed	Hash to continue from, so that several calls can be chained.
+			*
+			*	@return The hash of the provided bytes.
+			*/
+			static uint64					hash(void const*	data,
+												 size_t			size,
+												 uint64			seed = initialHash)		noexcept;
+
+			/**
+			*	@brief Hash a string.
+			*
+			*	@param str	The string to hash.
+			*	@param seed	Hash to continue from, so that several calls can be chained.
+			*
+			*	@return The hash of the provided string.
+			*/
+			static uint64					hash(std::string const&	str,
+												 uint64				seed = initialHash)		noexcept;
+
+			/**
+			*	@brief Combine a value to an existing hash.
+			*
+			*	@param seed		Hash to combine the value with.
+			*	@param value	Value to combine.
+			*
+			*	@return The combined hash.
+			*/
+			static uint64					combine(uint64 seed,
+													uint64 value)							noexcept;
+
+			/**
+			*	@brief Hash the whole content of a file.
+			*
+			*	@param file Path to the file to hash.
+			*
+			*	@return The hash of the file content if the file could be read, else an empty optional.
+			*/
+			static opt::optional<uint64>	hashFileContent(fs::path const& file)			noexcept;
+	};
+}
\ No newline at end of file
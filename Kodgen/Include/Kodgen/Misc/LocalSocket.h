@@ -0,0 +1,121 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <chrono>	//std::chrono::milliseconds
+
+#include "Kodgen/Misc/Filesystem.h"
+
+namespace kodgen
+{
+	/**
+	*	Stream socket bound to a path of the local filesystem (Unix domain socket), exchanging text lines.
+	*	Local sockets are only supported on Unix systems: on Windows, all operations fail.
+	*/
+	class LocalSocket
+	{
+		private:
+			/** Socket file descriptor, -1 if the socket is not opened. */
+			int							_descriptor		= -1;
+
+			/** Path the socket is bound to if it is a listening socket, else empty. */
+			fs::path					_boundPath;
+
+			/** Data received but not consumed by receiveLine yet. */
+			std::string					_receivedData;
+
+			/** Maximum time receiveLine and send wait for the peer, 0 to wait forever. */
+			std::chrono::milliseconds	_timeout		= std::chrono::milliseconds(0);
+
+			/** Maximum length of a line received by receiveLine, 0 for no limit. */
+			size_t						_maxLineLength	= 0u;
+
+		public:
+			LocalSocket()							= default;
+			LocalSocket(LocalSocket const&)			= delete;
+			LocalSocket(LocalSocket&& other)		noexcept;
+			~LocalSocket()							noexcept;
+
+			/**
+			*	@brief	Create a socket bound to the provided path and listen to incoming connections.
+			*			A socket file left at this path by a listening socket which doesn't exist anymore is replaced.
+			*			Fails if a socket still listens at this path, or if any other file exists at this path.
+			*
+			*	@param path Path to bind the socket to.
+			*
+			*	@return true if the socket listens, else false.
+			*/
+			bool	listen(fs::path const& path)						noexcept;
+
+			/**
+			*	@brief Wait for a connection on this listening socket.
+			*
+			*	@param timeout		Maximum time to wait for a connection.
+			*	@param out_client	Socket connected to the client if a connection has been accepted.
+			*
+			*	@return true if a connection has been accepted, else false.
+			*/
+			bool	accept(std::chrono::milliseconds	timeout,
+						   LocalSocket&					out_client)		noexcept;
+
+			/**
+			*	@brief Connect to a listening socket.
+			*
+			*	@param path Path the listening socket is bound to.
+			*
+			*	@return true if the socket is connected, else false.
+			*/
+			bool	connect(fs::path const& path)						noexcept;
+
+			/**
+			*	@brief Send data through this connected socket.
+			*
+			*	@param data The data to send.
+			*
+			*	@return true if all the data has been sent, else false.
+			*/
+			bool	send(std::string const& data)						noexcept;
+
+			/**
+			*	@brief	Limit the time this connected socket waits for its peer and the length of the lines it receives,
+			*			so that a peer which stalls or sends garbage can't block the caller forever.
+			*
+			*	@param timeout			Maximum time a receiveLine or send call waits for the peer, or 0 to wait forever.
+			*	@param maxLineLength	Maximum length of a line received by receiveLine, or 0 for no limit.
+			*
+			*	@return true if the limits have been applied, else false.
+			*/
+			bool	setLimits(std::chrono::milliseconds	timeout,
+							  size_t					maxLineLength)	noexcept;
+
+			/**
+			*	@brief Receive a line through this connected socket, blocking until a full line is received or a limit is hit (see setLimits).
+			*
+			*	@param out_line The received line, without the line feed.
+			*
+			*	@return true if a line has been received, false if the connection has been closed, a limit has been hit or an error occured.
+			*/
+			bool	receiveLine(std::string& out_line)					noexcept;
+
+			/**
+			*	@brief Close the socket. If it was a listening socket, the file it was bound to is removed.
+			*/
+			void	close()												noexcept;
+
+			/**
+			*	@brief Check whether the socket is opened.
+			*
+			*	@return true if the socket is opened, else false.
+			*/
+			bool	isValid()									const	noexcept;
+
+			LocalSocket& operator=(LocalSocket const&)	= delete;
+			LocalSocket& operator=(LocalSocket&& other)	noexcept;
+	};
+}
\ No newline at end of file
@@ -17,6 +17,9 @@
 #include "Kodgen/Parsing/ParsingResults/FileParsingResult.h"
 #include "Kodgen/Parsing/ParsingSettings.h"
 #include "Kodgen/Parsing/PropertyParser.h"
+#include "Kodgen/Parsing/PrecompiledHeader.h"
+#include "Kodgen/Parsing/TranslationUnitCache.h"
+#include "Kodgen/Parsing/UnsavedFile.h"
 #include "Kodgen/Misc/Filesystem.h"
 #include "Kodgen/Misc/ILogger.h"
 
@@ -25,8 +28,8 @@ namespace kodgen
 	class FileParser : public NamespaceParser
 	{
 		private:
-			/** Index used internally by libclang to process a translation unit. */
-			CXIndex								_clangIndex;
+			/** Index used internally by libclang to process a translation unit. It is shared with the cached translation units created with it. */
+			std::shared_ptr<void>				_clangIndex;
 
 			/** Property parser used to parse properties of all entities. */
 			PropertyParser						_propertyParser;		
@@ -34,6 +37,15 @@ namespace kodgen
 			/** Settings to use during parsing. */
 			std::shared_ptr<ParsingSettings>	_settings;
 
+			/** Precompiled header used to parse the files it applies to, shared by the copies of this parser. Can be nullptr. */
+			std::shared_ptr<PrecompiledHeader>	_precompiledHeader;
+
+			/** Translation units kept to reparse files faster, shared by the copies of this parser. */
+			std::shared_ptr<TranslationUnitCache>	_translationUnitCache;
+
+			/** Options used to parse translation units. */
+			static constexpr unsigned int const	_parsingOptions	= CXTranslationUnit_SkipFunctionBodies | CXTranslationUnit_Incomplete | CXTranslationUnit_KeepGoing;
+
 			/**
 			*	@brief This method is called at each node (cursor) of the parsing.
 			*
@@ -47,6 +59,57 @@ namespace kodgen
 														  CXCursor		parentCursor,
 														  CXClientData	clientData)						noexcept;
 
+			/**
+			*	@brief This method is called for each file included by a translation unit.
+			*
+			*	@param includedFile		The included file.
+			*	@param inclusionStack	Stack of inclusions leading to this file.
+			*	@param includeLength	Length of the inclusion stack. 0 for the translation unit main file.
+			*	@param clientData		Pointer to a data provided by the client. Must contain a FileParsingResult*.
+			*/
+			static void					collectInclusion(CXFile				includedFile,
+														 CXSourceLocation*	inclusionStack,
+														 unsigned int		includeLength,
+														 CXClientData		clientData)					noexcept;
+
+			/**
+			*	@brief Check whether the compiler reported any error or fatal diagnostic for a translation unit.
+			*
+			*	@param translationUnit The translation unit to check.
+			*
+			*	@return true if the translation unit has at least one error, else false.
+			*/
+			static bool					hasErrorDiagnostic(CXTranslationUnit const& translationUnit)	noexcept;
+
+			/**
+			*	@brief	Precompile the provided include directives and collect the files they include.
+			*			The include directives from the first one including a header without include guard are left out of the prelude.
+			*
+			*	@param preludeIncludes	Include directives to precompile.
+			*	@param isForced			Should all files be parsed with the precompiled header, whatever their include directives?
+			*	@param fingerprint		Fingerprint of the compilation arguments.
+			*
+			*	@return The built precompiled header, or nullptr if it could not be built.
+			*/
+			std::shared_ptr<PrecompiledHeader>	buildPrecompiledHeader(std::vector<std::string>	preludeIncludes,
+																	   bool						isForced,
+																	   uint64					fingerprint)	noexcept;
+
+			/**
+			*	@brief Parse a translation unit and fill the FileParsingResult. out_result.parsedFile must already be set.
+			*
+			*	@param toParseFile			Path to the main file of the translation unit, as given to libclang.
+			*	@param unsavedFiles			Files which content is read from memory instead of the disk.
+			*	@param precompiledHeader	Precompiled header to parse the file with. Can be nullptr.
+			*	@param out_result			Result filled while parsing the translation unit.
+			*
+			*	@return true if the parsing process finished without error, else false
+			*/
+			bool						parseTranslationUnit(std::string const&							toParseFile,
+															 std::vector<CXUnsavedFile>&				unsavedFiles,
+															 std::shared_ptr<PrecompiledHeader> const&	precompiledHeader,
+															 FileParsingResult&							out_result)	noexcept;
+
 			/**
 			*	@brief Push a new clean context to prepare translation unit parsing.
 			*
@@ -153,12 +216,50 @@ namespace kodgen
 			bool					parse(fs::path const&					toParseFile,
 										  FileParsingResult&				out_result)		noexcept;
 
+			/**
+			*	@brief	Parse a file which content is in memory and fill the FileParsingResult.
+			*			The file and the provided unsaved files don't need to exist on the disk, their content is read from memory instead.
+			*
+			*	@param toParseFile	Path of the file to parse, used to resolve its include directives.
+			*	@param fileContent	Content of the file to parse.
+			*	@param unsavedFiles	Other files (typically included headers) which content must be read from memory instead of the disk.
+			*	@param out_result	Result filled while parsing the file.
+			*
+			*	@return true if the parsing process finished without error, else false
+			*/
+			bool					parse(fs::path const&					toParseFile,
+										  std::string const&				fileContent,
+										  std::vector<UnsavedFile> const&	unsavedFiles,
+										  FileParsingResult&				out_result)		noexcept;
+
+			/**
+			*	@brief	Build the precompiled header to parse the provided files with if ParsingSettings::shouldUsePrecompiledHeader is true,
+			*			or keep the current one if it is still up to date. Copies of this parser made afterwards share the precompiled header.
+			*			A precompiled header including any of the provided files or any file of the generated directories is discarded
+			*			since these files change during the generation, and libclang refuses precompiled headers older than their included files.
+			*			The parsing settings must have been initialized.
+			*
+			*	@param toParseFiles			Files which are about to be parsed.
+			*	@param generatedDirectories	Directories which files are written during the generation.
+			*
+			*	@return true if a precompiled header is available to parse the provided files, else false.
+			*/
+			bool					preparePrecompiledHeader(std::vector<fs::path> const&	toParseFiles,
+															 std::vector<fs::path> const&	generatedDirectories)	noexcept;
+
 			/**
 			*	@brief Getter for _settings field.
 			* 
 			*	@return _settings.
 			*/
 			inline ParsingSettings&	getSettings()											noexcept;
+
+			/**
+			*	@brief Getter for _precompiledHeader field.
+			* 
+			*	@return _precompiledHeader, nullptr if files are parsed without precompiled header.
+			*/
+			inline std::shared_ptr<PrecompiledHeader> const&	getPrecompiledHeader()	const	noexcept;
 	};
 
 	#include "Kodgen/Parsing/FileParser.inl"
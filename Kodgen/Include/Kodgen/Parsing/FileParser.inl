@@ -16,4 +16,9 @@ inline ParsingSettings& FileParser::getSettings() noexcept
 	assert(_settings.use_count() != 0);
 
 	return *_settings;
+}
+
+inline std::shared_ptr<PrecompiledHeader> const& FileParser::getPrecompiledHeader() const noexcept
+{
+	return _precompiledHeader;
 }
\ No newline at end of file
@@ -51,6 +51,16 @@ namespace kodgen
 			/** Structure containing the whole struct/class hierarchy linked to parsed structs/classes. */
 			StructClassTree					structClassTree;
 
+			/** All files included (directly or transitively) by the parsed file. */
+			std::vector<fs::path>			includedFiles;
+
+			/**
+			*	Did the compiler report any error while parsing the file?
+			*	Entities following an error might be missing from the result, so the file should be parsed again
+			*	once the error cause (for example a not yet generated macro) is fixed.
+			*/
+			bool							hasCompilationErrors	= false;
+
 			/**
 			*	@brief Call a visitor function on each entity of the provided type(s) contained in a file.
 			* 
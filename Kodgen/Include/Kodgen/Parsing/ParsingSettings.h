@@ -133,6 +133,24 @@ namespace kodgen
 			void	loadProjectIncludeDirectories(toml::value const&	parsingSettings,
 												  ILogger*				logger)				noexcept;
 
+			/**
+			*	@brief Load the shouldUsePrecompiledHeader and precompiledHeaderPrelude settings from toml.
+			*
+			*	@param parsingSettings	Toml content.
+			*	@param logger			Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void	loadPrecompiledHeaderSettings(toml::value const&	parsingSettings,
+												  ILogger*				logger)				noexcept;
+
+			/**
+			*	@brief Load the shouldReuseTranslationUnits and translationUnitCacheMemoryLimit settings from toml.
+			*
+			*	@param parsingSettings	Toml content.
+			*	@param logger			Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void	loadTranslationUnitReuseSettings(toml::value const&	parsingSettings,
+													 ILogger*				logger)			noexcept;
+
 		protected:
 			virtual bool loadSettingsValues(toml::value const&	tomlData,
 											ILogger*			logger)		noexcept override;
@@ -187,6 +205,31 @@ namespace kodgen
 			*/
 			bool									shouldLogDiagnostic				= false;
 
+			/**
+			*	Should files be parsed with a precompiled header?
+			*	The precompiled header is built from precompiledHeaderPrelude if it is set, else from the longest sequence
+			*	of include directives the parsed files start with. It is only rebuilt when the compilation arguments,
+			*	the prelude or any of the precompiled headers change.
+			*	The precompiled headers must be protected by include guards or #pragma once since the parsed files include them again.
+			*/
+			bool									shouldUsePrecompiledHeader		= false;
+
+			/**
+			*	Header precompiled and implicitly included by all the parsed files when shouldUsePrecompiledHeader is true.
+			*	If empty, the prelude is detected from the parsed files, and is only used for the files starting with it.
+			*/
+			fs::path								precompiledHeaderPrelude;
+
+			/**
+			*	Should the translation unit of parsed files be kept to reparse them faster the next time they are parsed,
+			*	like between generation iterations or in watch mode? libclang then only parses again the part of a file
+			*	following its preamble (its leading include directives) if the preamble didn't change.
+			*/
+			bool									shouldReuseTranslationUnits		= false;
+
+			/** Maximum memory (in MB) used by the kept translation units. The least recently parsed ones are released first. */
+			uint32									translationUnitCacheMemoryLimit	= 2048u;
+
 			virtual ~ParsingSettings() = default;
 
 			/**
@@ -250,5 +293,14 @@ namespace kodgen
 			*	@return true if the compiler is valid on the running computer, else false.
 			*/
 			bool											setCompilerExeName(std::string const& compilerExeName)		noexcept;
+
+			/**
+			*	@brief	Compute a fingerprint of all the settings used to build the compilation arguments
+			*			and to drive the parsing process.
+			*			Two ParsingSettings with the same fingerprint produce the same parsing results.
+			* 
+			*	@return The fingerprint of these settings.
+			*/
+			uint64											computeFingerprint()								const	noexcept;
 	};
 }
\ No newline at end of file
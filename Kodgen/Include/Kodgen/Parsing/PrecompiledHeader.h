@@ -0,0 +1,188 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <istream>
+
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Precompiled header built from a prelude of include directives, used to parse the files starting with these include directives.
+	*	The precompiled header and its prelude are written in the temporary directory, and removed when the object is destroyed.
+	*/
+	class PrecompiledHeader
+	{
+		private:
+			/** Include directives of the prelude, as returned by getLeadingIncludes. */
+			std::vector<std::string>	_preludeIncludes;
+
+			/** Should all files be parsed with this precompiled header, whatever their include directives? */
+			bool						_isForced		= false;
+
+			/** Fingerprint of the compilation arguments used to build the precompiled header. */
+			uint64						_fingerprint	= 0u;
+
+			/** Path to the prelude header the precompiled header is built from. */
+			fs::path					_preludeFile;
+
+			/** Path to the precompiled header file. */
+			fs::path					_file;
+
+			/** All the files included by the prelude. */
+			std::vector<fs::path>		_includedFiles;
+
+			/** Last write time of the precompiled header file. */
+			fs::file_time_type			_buildTime;
+
+			/**
+			*	@brief Check whether the provided include directives start with the prelude include directives.
+			*
+			*	@param includes Leading include directives of a file, as returned by getLeadingIncludes.
+			*
+			*	@return true if the include directives start with the prelude include directives, else false.
+			*/
+			bool						appliesTo(std::vector<std::string> const& includes)	const	noexcept;
+
+		public:
+			/**
+			*	@param preludeIncludes	Include directives of the prelude, as returned by getLeadingIncludes.
+			*	@param isForced			Should all files be parsed with this precompiled header, whatever their include directives?
+			*	@param fingerprint		Fingerprint of the compilation arguments used to build the precompiled header.
+			*/
+			PrecompiledHeader(std::vector<std::string>	preludeIncludes,
+							  bool						isForced,
+							  uint64					fingerprint)								noexcept;
+			PrecompiledHeader(PrecompiledHeader const&)												= delete;
+			PrecompiledHeader(PrecompiledHeader&&)													= delete;
+			~PrecompiledHeader()																	noexcept;
+
+			/**
+			*	@brief	Collect the include directives a file starts with, skipping comments, #pragma once and include guards.
+			*			Quoted includes found next to the file are converted to absolute paths so that the same header gets the same
+			*			spelling in all the files.
+			*
+			*	@param file Path to the file to read.
+			*
+			*	@return The leading include directives of the file, with their delimiters (ex: <vector> or "/path/to/Header.h").
+			*/
+			static std::vector<std::string>	getLeadingIncludes(fs::path const& file)								noexcept;
+
+			/**
+			*	@brief Collect the include directives some file content starts with, like getLeadingIncludes(file) does for a file on the disk.
+			*
+			*	@param file		Path of the file, used to find quoted includes next to it. The file doesn't need to exist.
+			*	@param content	Stream to read the file content from.
+			*
+			*	@return The leading include directives of the file content.
+			*/
+			static std::vector<std::string>	getLeadingIncludes(fs::path const&	file,
+															   std::istream&	content)								noexcept;
+
+			/**
+			*	@brief	Find the sequence of leading include directives which saves the most parsing when precompiled,
+			*			that is the one maximizing its length times the number of files starting with it.
+			*
+			*	@param files Files to look for a common include prefix in.
+			*
+			*	@return The include directives of the prefix, or an empty vector if no prefix is shared by at least 2 files.
+			*/
+			static std::vector<std::string>	findCommonIncludePrefix(std::vector<fs::path> const& files)				noexcept;
+
+			/**
+			*	@brief Write the prelude header including all the prelude include directives.
+			*
+			*	@return true if the prelude has been written, else false.
+			*/
+			bool							writePrelude()													const	noexcept;
+
+			/**
+			*	@brief	Record the files included by the prelude and the build time, once the precompiled header file has been written.
+			*
+			*	@param includedFiles All the files included by the prelude.
+			*/
+			void							onBuilt(std::vector<fs::path>&& includedFiles)							noexcept;
+
+			/**
+			*	@brief Check whether a file can be parsed with this precompiled header.
+			*
+			*	@param file Path to the file to parse.
+			*
+			*	@return true if the precompiled header is forced or if the file starts with the prelude include directives, else false.
+			*/
+			bool							appliesTo(fs::path const& file)									const	noexcept;
+
+			/**
+			*	@brief Check whether a file which content is in memory can be parsed with this precompiled header.
+			*
+			*	@param file		Path of the file to parse. The file doesn't need to exist.
+			*	@param content	Content of the file to parse.
+			*
+			*	@return true if the precompiled header is forced or if the content starts with the prelude include directives, else false.
+			*/
+			bool							appliesTo(fs::path const&		file,
+													  std::string const&	content)							const	noexcept;
+
+			/**
+			*	@brief	Check whether the precompiled header can still be loaded by libclang,
+			*			which refuses precompiled headers older than any of their included files.
+			*
+			*	@return true if none of the files included by the prelude changed since the precompiled header was built, else false.
+			*/
+			bool							isUpToDate()													const	noexcept;
+
+			/**
+			*	@brief Getter for _preludeIncludes field.
+			*
+			*	@return _preludeIncludes.
+			*/
+			std::vector<std::string> const&	getPreludeIncludes()											const	noexcept;
+
+			/**
+			*	@brief Getter for _isForced field.
+			*
+			*	@return _isForced.
+			*/
+			bool							isForced()														const	noexcept;
+
+			/**
+			*	@brief Getter for _fingerprint field.
+			*
+			*	@return _fingerprint.
+			*/
+			uint64							getFingerprint()												const	noexcept;
+
+			/**
+			*	@brief Getter for _preludeFile field.
+			*
+			*	@return _preludeFile.
+			*/
+			fs::path const&					getPreludeFile()												const	noexcept;
+
+			/**
+			*	@brief Getter for _file field.
+			*
+			*	@return _file.
+			*/
+			fs::path const&					getFile()														const	noexcept;
+
+			/**
+			*	@brief Getter for _includedFiles field.
+			*
+			*	@return _includedFiles.
+			*/
+			std::vector<fs::path> const&	getIncludedFiles()												const	noexcept;
+
+			PrecompiledHeader& operator=(PrecompiledHeader const&)	= delete;
+			PrecompiledHeader& operator=(PrecompiledHeader&&)		= delete;
+	};
+}
\ No newline at end of file
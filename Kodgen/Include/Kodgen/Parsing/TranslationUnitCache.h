@@ -0,0 +1,113 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include <memory>	//std::shared_ptr
+#include <mutex>
+
+#include <clang-c/Index.h>
+
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Translation units kept after parsing so that files parsed again are reparsed with clang_reparseTranslationUnit.
+	*	A translation unit is taken from the cache while it is used, so it is never used by several threads at the same time.
+	*	The least recently used translation units are disposed when the memory they use exceeds a limit.
+	*/
+	class TranslationUnitCache
+	{
+		private:
+			struct Entry
+			{
+				/** Path to the main file of the translation unit. */
+				fs::path				file;
+
+				/** The cached translation unit. */
+				CXTranslationUnit		translationUnit			= nullptr;
+
+				/** Index the translation unit has been created with, which must outlive the translation unit. */
+				std::shared_ptr<void>	clangIndex;
+
+				/** Fingerprint of the compilation arguments the translation unit has been created with. */
+				uint64					argumentsFingerprint	= 0u;
+
+				/** Memory (in bytes) used by the translation unit when it has been cached. */
+				uint64					memoryUsage				= 0u;
+			};
+
+			/** Cached translation units, from the most recently to the least recently used. */
+			std::list<Entry>													_entries;
+
+			/** Position of the cached translation unit of each file in _entries. A file has at most one cached translation unit. */
+			std::unordered_map<fs::path, std::list<Entry>::iterator, PathHash>	_entryIndices;
+
+			/** Memory (in bytes) used by all the cached translation units. */
+			uint64																_memoryUsage	= 0u;
+
+			/** Mutex protecting the cached entries. */
+			std::mutex															_mutex;
+
+			/**
+			*	@brief Compute the memory used by a translation unit.
+			*
+			*	@param translationUnit The translation unit.
+			*
+			*	@return The memory (in bytes) used by the translation unit.
+			*/
+			static uint64	computeMemoryUsage(CXTranslationUnit translationUnit)	noexcept;
+
+		public:
+			TranslationUnitCache()										= default;
+			TranslationUnitCache(TranslationUnitCache const&)			= delete;
+			TranslationUnitCache(TranslationUnitCache&&)				= delete;
+			~TranslationUnitCache()										noexcept;
+
+			/**
+			*	@brief	Take the cached translation unit of a file out of the cache.
+			*			A translation unit created with other compilation arguments is disposed instead.
+			*
+			*	@param file					Path to the main file of the translation unit.
+			*	@param argumentsFingerprint	Fingerprint of the compilation arguments the file is parsed with.
+			*	@param out_clangIndex		Index the translation unit has been created with, which must outlive it.
+			*
+			*	@return The cached translation unit, or nullptr if the file has no valid cached translation unit.
+			*/
+			CXTranslationUnit	acquire(fs::path const&			file,
+										uint64					argumentsFingerprint,
+										std::shared_ptr<void>&	out_clangIndex)		noexcept;
+
+			/**
+			*	@brief	Put a translation unit (back) in the cache as the most recently used one, replacing the translation unit cached for the same file if any,
+			*			then dispose the least recently used translation units until the memory limit is met.
+			*
+			*	@param file					Path to the main file of the translation unit.
+			*	@param translationUnit		The translation unit to cache.
+			*	@param clangIndex			Index the translation unit has been created with.
+			*	@param argumentsFingerprint	Fingerprint of the compilation arguments the translation unit has been created with.
+			*	@param memoryLimit			Maximum memory (in bytes) used by all the cached translation units.
+			*/
+			void				release(fs::path const&			file,
+										CXTranslationUnit		translationUnit,
+										std::shared_ptr<void>	clangIndex,
+										uint64					argumentsFingerprint,
+										uint64					memoryLimit)		noexcept;
+
+			/**
+			*	@brief Dispose all the cached translation units.
+			*/
+			void				clear()												noexcept;
+
+			TranslationUnitCache& operator=(TranslationUnitCache const&)	= delete;
+			TranslationUnitCache& operator=(TranslationUnitCache&&)			= delete;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+
+#include "Kodgen/Misc/Filesystem.h"
+
+namespace kodgen
+{
+	/**
+	*	File which content is provided in memory to the parser, used instead of the file on the disk if any.
+	*/
+	struct UnsavedFile
+	{
+		/** Path of the file, as it is included by the parsed files. The file doesn't need to exist on the disk. */
+		fs::path	path;
+
+		/** Content of the file. */
+		std::string	content;
+	};
+}
\ No newline at end of file
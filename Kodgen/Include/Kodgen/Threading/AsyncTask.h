@@ -0,0 +1,191 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include "Kodgen/Config.h"
+
+#ifdef KODGEN_COROUTINES_ENABLED
+
+#include <coroutine>
+#include <memory>		//std::shared_ptr
+#include <optional>
+#include <exception>	//std::exception_ptr
+#include <type_traits>	//std::is_void_v
+
+#include "Kodgen/Threading/ThreadPool.h"
+#include "Kodgen/Threading/TaskHelper.h"
+
+namespace kodgen
+{
+	/**
+	*	Awaiter suspending an AsyncTask coroutine until a task of its thread pool finished, without blocking any thread.
+	*	The coroutine is resumed by a task depending on the awaited task, so it is only scheduled once the result is ready.
+	*/
+	template <typename ResultType>
+	class TaskAwaiter
+	{
+		private:
+			/** Awaited task. */
+			std::shared_ptr<TaskBase>	_task;
+
+		public:
+			/**
+			*	@param task Awaited task. It must return ResultType, and its result must not be retrieved by anything else.
+			*/
+			explicit TaskAwaiter(std::shared_ptr<TaskBase> task)	noexcept;
+
+			bool		await_ready()		const	noexcept;
+
+			template <typename PromiseType>
+			void		await_suspend(std::coroutine_handle<PromiseType> handle)	noexcept;
+
+			/**
+			*	@exception Any exception propagated from the awaited task execution.
+			*
+			*	@return The result of the awaited task.
+			*/
+			ResultType	await_resume();
+	};
+
+	/**
+	*	State shared by the promises of all the AsyncTask coroutines.
+	*/
+	class AsyncTaskPromiseBase
+	{
+		private:
+			/** Thread pool running the coroutine. */
+			ThreadPool&					_threadPool;
+
+		protected:
+			/** Task completed with the coroutine result once the coroutine returned. It is submitted when the coroutine returns. */
+			std::shared_ptr<TaskBase>	_completionTask;
+
+			/** Exception thrown by the coroutine, propagated to the completion task. */
+			std::exception_ptr			_exception;
+
+		public:
+			/** Awaiter starting the coroutine in a task of its thread pool instead of on the calling thread. */
+			struct InitialAwaiter
+			{
+				ThreadPool&	threadPool;
+
+				bool	await_ready()							const	noexcept	{ return false; }
+				void	await_suspend(std::coroutine_handle<> handle)	noexcept;
+				void	await_resume()							const	noexcept	{ }
+			};
+
+			/** Awaiter submitting the completion task once the coroutine returned. */
+			struct FinalAwaiter
+			{
+				bool	await_ready()									const	noexcept	{ return false; }
+
+				template <typename PromiseType>
+				void	await_suspend(std::coroutine_handle<PromiseType> handle)		noexcept;
+
+				void	await_resume()									const	noexcept	{ }
+			};
+
+			/**
+			*	Coroutines running on a thread pool take it as their first parameter.
+			*/
+			template <typename... Args>
+			AsyncTaskPromiseBase(ThreadPool&	threadPool,
+								 Args const&...)					noexcept;
+
+			/**
+			*	Member function coroutines take the thread pool as their first parameter, following the object.
+			*/
+			template <typename Object, typename... Args>
+			AsyncTaskPromiseBase(Object const&,
+								 ThreadPool&	threadPool,
+								 Args const&...)					noexcept;
+
+			InitialAwaiter	initial_suspend()						noexcept;
+			FinalAwaiter	final_suspend()							noexcept;
+			void			unhandled_exception()					noexcept;
+
+			/**
+			*	@brief Getter for the thread pool running the coroutine.
+			*
+			*	@return The thread pool running the coroutine.
+			*/
+			ThreadPool&		getThreadPool()					const	noexcept;
+	};
+
+	/**
+	*	Promise receiving the value returned by an AsyncTask coroutine.
+	*/
+	template <typename ResultType>
+	class AsyncTaskPromiseResult : public AsyncTaskPromiseBase
+	{
+		protected:
+			/** Value returned by the coroutine. */
+			std::optional<ResultType>	_result;
+
+		public:
+			using AsyncTaskPromiseBase::AsyncTaskPromiseBase;
+
+			template <typename ValueType>
+			void	return_value(ValueType&& value)	noexcept(std::is_nothrow_constructible_v<ResultType, ValueType&&>);
+	};
+
+	template <>
+	class AsyncTaskPromiseResult<void> : public AsyncTaskPromiseBase
+	{
+		public:
+			using AsyncTaskPromiseBase::AsyncTaskPromiseBase;
+
+			void	return_void()	noexcept	{ }
+	};
+
+	/**
+	*	Coroutine running on a thread pool, only available when compiling as C++20.
+	*	The coroutine takes the thread pool as its first parameter, after the object for member functions, and starts in a task
+	*	of the pool. It can co_await other AsyncTasks and pool tasks (through TaskAwaiter) without blocking the worker running it.
+	*	Its completion is a regular task of the pool, so that it can be used as a dependency of other tasks.
+	*	The coroutine frame is destroyed once the completion task ran, so a coroutine which never completes leaks its frame.
+	*/
+	template <typename ResultType>
+	class AsyncTask
+	{
+		public:
+			class promise_type : public AsyncTaskPromiseResult<ResultType>
+			{
+				public:
+					using AsyncTaskPromiseResult<ResultType>::AsyncTaskPromiseResult;
+
+					AsyncTask	get_return_object()	noexcept;
+			};
+
+		private:
+			/** Task completed with the coroutine result. */
+			std::shared_ptr<TaskBase>	_completionTask;
+
+			explicit AsyncTask(std::shared_ptr<TaskBase> completionTask)	noexcept;
+
+		public:
+			/**
+			*	@brief	Getter for the task completed with the coroutine result.
+			*			It can be used as a dependency of other tasks, which can retrieve the result with TaskHelper.
+			*
+			*	@return The task completed with the coroutine result.
+			*/
+			std::shared_ptr<TaskBase> const&	getTask()				const	noexcept;
+
+			/**
+			*	@brief Await the coroutine from another AsyncTask coroutine. Its result can only be retrieved once.
+			*
+			*	@return An awaiter resuming the awaiting coroutine once this coroutine completed.
+			*/
+			TaskAwaiter<ResultType>				operator co_await()		const	noexcept;
+	};
+
+	#include "Kodgen/Threading/AsyncTask.inl"
+}
+
+#endif
\ No newline at end of file
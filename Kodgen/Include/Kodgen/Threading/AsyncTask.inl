@@ -0,0 +1,144 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+template <typename ResultType>
+TaskAwaiter<ResultType>::TaskAwaiter(std::shared_ptr<TaskBase> task) noexcept:
+	_task{std::move(task)}
+{
+}
+
+template <typename ResultType>
+bool TaskAwaiter<ResultType>::await_ready() const noexcept
+{
+	return _task->hasFinished();
+}
+
+template <typename ResultType>
+template <typename PromiseType>
+void TaskAwaiter<ResultType>::await_suspend(std::coroutine_handle<PromiseType> handle) noexcept
+{
+	//Continuations run before new work so that started pipelines complete first
+	handle.promise().getThreadPool().submitTask("Coroutine continuation", [handle](TaskBase*) { handle.resume(); }, { _task }, ETaskPriority::High);
+}
+
+template <typename ResultType>
+ResultType TaskAwaiter<ResultType>::await_resume()
+{
+	return TaskHelper::getResult<ResultType>(_task.get());
+}
+
+inline void AsyncTaskPromiseBase::InitialAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept
+{
+	threadPool.submitTask("Coroutine", [handle](TaskBase*) { handle.resume(); });
+}
+
+template <typename PromiseType>
+void AsyncTaskPromiseBase::FinalAwaiter::await_suspend(std::coroutine_handle<PromiseType> handle) noexcept
+{
+	AsyncTaskPromiseBase& promise = handle.promise();
+
+	//The completion task destroys the coroutine frame, which must not be accessed once the task is submitted
+	ThreadPool&								threadPool		= promise._threadPool;
+	std::vector<std::shared_ptr<TaskBase>>	completionTask	= { promise._completionTask };
+
+	threadPool.submitTasks(completionTask);
+}
+
+template <typename... Args>
+AsyncTaskPromiseBase::AsyncTaskPromiseBase(ThreadPool& threadPool, Args const&...) noexcept:
+	_threadPool{threadPool}
+{
+}
+
+template <typename Object, typename... Args>
+AsyncTaskPromiseBase::AsyncTaskPromiseBase(Object const&, ThreadPool& threadPool, Args const&...) noexcept:
+	_threadPool{threadPool}
+{
+}
+
+inline AsyncTaskPromiseBase::InitialAwaiter AsyncTaskPromiseBase::initial_suspend() noexcept
+{
+	return InitialAwaiter{ _threadPool };
+}
+
+inline AsyncTaskPromiseBase::FinalAwaiter AsyncTaskPromiseBase::final_suspend() noexcept
+{
+	return FinalAwaiter{};
+}
+
+inline void AsyncTaskPromiseBase::unhandled_exception() noexcept
+{
+	_exception = std::current_exception();
+}
+
+inline ThreadPool& AsyncTaskPromiseBase::getThreadPool() const noexcept
+{
+	return _threadPool;
+}
+
+template <typename ResultType>
+template <typename ValueType>
+void AsyncTaskPromiseResult<ResultType>::return_value(ValueType&& value) noexcept(std::is_nothrow_constructible_v<ResultType, ValueType&&>)
+{
+	_result.emplace(std::forward<ValueType>(value));
+}
+
+template <typename ResultType>
+AsyncTask<ResultType> AsyncTask<ResultType>::promise_type::get_return_object() noexcept
+{
+	std::coroutine_handle<promise_type> handle = std::coroutine_handle<promise_type>::from_promise(*this);
+
+	//The completion task moves the coroutine result to its own result, so that it can be retrieved like any task result
+	this->_completionTask = ThreadPool::createTask("Coroutine completion", [handle](TaskBase*) -> ResultType
+												   {
+													   promise_type&		promise		= handle.promise();
+													   std::exception_ptr	exception	= promise._exception;
+
+													   if constexpr (std::is_void_v<ResultType>)
+													   {
+														   handle.destroy();
+
+														   if (exception != nullptr)
+														   {
+															   std::rethrow_exception(exception);
+														   }
+													   }
+													   else
+													   {
+														   std::optional<ResultType> result = std::move(promise._result);
+
+														   handle.destroy();
+
+														   if (exception != nullptr)
+														   {
+															   std::rethrow_exception(exception);
+														   }
+
+														   return std::move(*result);
+													   }
+												   }, {}, ETaskPriority::High);
+
+	return AsyncTask(this->_completionTask);
+}
+
+template <typename ResultType>
+AsyncTask<ResultType>::AsyncTask(std::shared_ptr<TaskBase> completionTask) noexcept:
+	_completionTask{std::move(completionTask)}
+{
+}
+
+template <typename ResultType>
+std::shared_ptr<TaskBase> const& AsyncTask<ResultType>::getTask() const noexcept
+{
+	return _completionTask;
+}
+
+template <typename ResultType>
+TaskAwaiter<ResultType> AsyncTask<ResultType>::operator co_await() const noexcept
+{
+	return TaskAwaiter<ResultType>(_completionTask);
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	enum class ETaskPriority : uint8
+	{
+		/** Run once no task of higher priority is ready. */
+		Low = 0,
+
+		/** Default priority of submitted tasks. */
+		Normal,
+
+		/** Run before any ready task of lower priority, wherever it is queued. */
+		High,
+
+		/**
+		*	Internal use only.
+		*/
+		Count
+	};
+}
\ No newline at end of file
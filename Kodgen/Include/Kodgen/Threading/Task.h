@@ -7,40 +7,99 @@
 
 #pragma once
 
-#include <functional>		//std::function
-#include <unordered_set>
+#include <vector>
+#include <string>
 #include <memory>			//std::shared_ptr
 #include <atomic>
-#include <future>
-#include <chrono>			//std::chrono::nanoseconds
-#include <cassert>
+#include <optional>
+#include <exception>		//std::exception_ptr
+#include <type_traits>		//std::conditional_t, std::is_void_v
 
 #include "Kodgen/Threading/TaskBase.h"
 
 namespace kodgen
 {
+	/**
+	*	Task holding the result of its execution.
+	*	The callable is stored by the derived CallableTask, so that the result can be retrieved without knowing the callable type.
+	*/
 	template <typename ReturnType>
-	class Task final : public TaskBase
+	class Task : public TaskBase
 	{
 		friend class TaskHelper;
 
 		private:
-			/** Underlying task to execute. */
-			std::packaged_task<ReturnType(TaskBase*)>	_task;
+			/** Result of the call of the callable, empty until the task executed or if it threw. void results are stored as a bool. */
+			std::optional<std::conditional_t<std::is_void_v<ReturnType>, bool, ReturnType>>	_result;
 
-			/** Result of the call of the underlying _task. */
-			std::future<ReturnType>						_result;
+			/** Exception thrown by the callable, rethrown when the result is retrieved. */
+			std::exception_ptr																	_exception;
+
+			/** Has the task finished executing? */
+			std::atomic_bool																	_hasFinished	= false;
+
+		protected:
+			/**
+			*	@brief Call the callable of the task and store its result.
+			*
+			*	@param callable The callable of the task.
+			*/
+			template <typename Callable>
+			void						run(Callable& callable)		noexcept;
 
 		public:
 			Task()														= delete;
 			Task(char const*								name,
-				 std::function<ReturnType(TaskBase*)>&&		task,
 				 std::vector<std::shared_ptr<TaskBase>>&&	deps = {})	noexcept;
 
 			virtual bool				isReadyToExecute()	const	noexcept override;
-			virtual void				execute()					noexcept override;
 			virtual bool				hasFinished()		const	noexcept override;
 	};
 
+	/**
+	*	Task storing its callable inline, so that the task, its callable and its result are allocated at once.
+	*/
+	template <typename ReturnType, typename Callable>
+	class CallableTask : public Task<ReturnType>
+	{
+		private:
+			/** Callable to execute. */
+			Callable	_callable;
+
+		public:
+			CallableTask()												= delete;
+			template <typename CallableArg>
+			CallableTask(char const*								name,
+						 CallableArg&&								callable,
+						 std::vector<std::shared_ptr<TaskBase>>&&	deps)	noexcept;
+
+			virtual void	execute()	noexcept override;
+	};
+
+	/**
+	*	Copy of the name of a NamedCallableTask.
+	*	It is the first base class of the task so that the name is constructed before the TaskBase pointing to it.
+	*/
+	struct TaskNameStorage
+	{
+		/** Name of the task. */
+		std::string	name;
+	};
+
+	/**
+	*	CallableTask owning a copy of its name, for names which don't outlive the task. The copy is stored in the task,
+	*	so it is allocated with the task, unless the name is too long for the small string optimization.
+	*/
+	template <typename ReturnType, typename Callable>
+	class NamedCallableTask final : private TaskNameStorage, public CallableTask<ReturnType, Callable>
+	{
+		public:
+			NamedCallableTask()												= delete;
+			template <typename CallableArg>
+			NamedCallableTask(std::string const&						name,
+							  CallableArg&&								callable,
+							  std::vector<std::shared_ptr<TaskBase>>&&	deps)	noexcept;
+	};
+
 	#include "Kodgen/Threading/Task.inl"
 }
\ No newline at end of file
@@ -6,13 +6,35 @@
 */
 
 template <typename ReturnType>
-Task<ReturnType>::Task(char const* name, std::function<ReturnType(TaskBase*)>&& task, std::vector<std::shared_ptr<TaskBase>>&& deps) noexcept:
-	TaskBase(name, std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps)),
-	_task{std::forward<std::function<ReturnType(TaskBase*)>>(task)},
-	_result{_task.get_future()}
+Task<ReturnType>::Task(char const* name, std::vector<std::shared_ptr<TaskBase>>&& deps) noexcept:
+	TaskBase(name, std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps))
 {
 }
 
+template <typename ReturnType>
+template <typename Callable>
+void Task<ReturnType>::run(Callable& callable) noexcept
+{
+	try
+	{
+		if constexpr (std::is_void_v<ReturnType>)
+		{
+			callable(this);
+			_result.emplace(true);
+		}
+		else
+		{
+			_result.emplace(callable(this));
+		}
+	}
+	catch (...)
+	{
+		_exception = std::current_exception();
+	}
+
+	_hasFinished = true;
+}
+
 template <typename ReturnType>
 bool Task<ReturnType>::isReadyToExecute() const noexcept
 {
@@ -29,13 +51,29 @@ bool Task<ReturnType>::isReadyToExecute() const noexcept
 }
 
 template <typename ReturnType>
-void Task<ReturnType>::execute() noexcept
+bool Task<ReturnType>::hasFinished() const noexcept
 {
-	_task(this);
+	return _hasFinished;
 }
 
-template <typename ReturnType>
-bool Task<ReturnType>::hasFinished() const noexcept
+template <typename ReturnType, typename Callable>
+template <typename CallableArg>
+CallableTask<ReturnType, Callable>::CallableTask(char const* name, CallableArg&& callable, std::vector<std::shared_ptr<TaskBase>>&& deps) noexcept:
+	Task<ReturnType>(name, std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps)),
+	_callable{std::forward<CallableArg>(callable)}
+{
+}
+
+template <typename ReturnType, typename Callable>
+void CallableTask<ReturnType, Callable>::execute() noexcept
+{
+	this->run(_callable);
+}
+
+template <typename ReturnType, typename Callable>
+template <typename CallableArg>
+NamedCallableTask<ReturnType, Callable>::NamedCallableTask(std::string const& name, CallableArg&& callable, std::vector<std::shared_ptr<TaskBase>>&& deps) noexcept:
+	TaskNameStorage{name},
+	CallableTask<ReturnType, Callable>(TaskNameStorage::name.c_str(), std::forward<CallableArg>(callable), std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps))
 {
-	return !_result.valid() || _result.wait_for(std::chrono::nanoseconds(0)) == std::future_status::ready;
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <cstddef>	//std::size_t, std::max_align_t
+#include <new>		//std::align_val_t
+
+namespace kodgen
+{
+	/**
+	*	Pool of memory blocks the tasks are allocated from, so that submitting a task doesn't hit the heap once the pool is warm.
+	*	Blocks are grouped by size classes. Each thread keeps its own free blocks, so allocating and releasing a block doesn't need
+	*	any synchronization. Tasks are often released by another thread than the one which allocated them, so threads give their
+	*	extra free blocks back to a shared cache by batches, from which the other threads refill.
+	*	Memory is never released to the system, the shared cache and its chunks are kept alive until the program exits
+	*	so that tasks can still be released by the destructors of static objects.
+	*/
+	class TaskBlockPool
+	{
+		private:
+			struct FreeBlock;
+			struct ThreadCache;
+			struct SharedCache;
+
+			/** Free blocks of the current thread. */
+			static thread_local ThreadCache	_threadCache;
+
+			/**
+			*	@brief Getter for the cache shared by all threads. It is constructed on first use and never destroyed.
+			*
+			*	@return The shared cache.
+			*/
+			static SharedCache&				getSharedCache()								noexcept;
+
+			/**
+			*	@brief Refill the current thread cache from the shared cache, or from a new chunk if the shared cache is empty.
+			*
+			*	@param sizeClass Size class of the blocks to refill.
+			*/
+			static void						refill(std::size_t sizeClass)					noexcept;
+
+		public:
+			/** Alignment of all the blocks of the pool. */
+			static constexpr std::size_t	blockAlignment	= alignof(std::max_align_t);
+
+			TaskBlockPool()		= delete;
+			~TaskBlockPool()	= delete;
+
+			/**
+			*	@brief	Allocate a block.
+			*			Sizes bigger than the biggest size class are allocated with the global operator new.
+			*
+			*	@param size Size in bytes of the block.
+			*
+			*	@return The allocated block, aligned on blockAlignment.
+			*/
+			static void*					allocate(std::size_t size)						noexcept;
+
+			/**
+			*	@brief Release a block allocated by allocate.
+			*
+			*	@param block	The block to release.
+			*	@param size		Size in bytes the block has been allocated with.
+			*/
+			static void						deallocate(void*		block,
+													   std::size_t	size)					noexcept;
+	};
+
+	/**
+	*	Allocator drawing from the TaskBlockPool, so that std::allocate_shared puts a task and its control block in a pooled block.
+	*/
+	template <typename T>
+	class TaskAllocator
+	{
+		public:
+			using value_type = T;
+
+			TaskAllocator()									= default;
+			template <typename U>
+			TaskAllocator(TaskAllocator<U> const&)			noexcept;
+
+			/**
+			*	@brief Allocate uninitialized storage for count objects of type T.
+			*
+			*	@param count Number of objects to allocate storage for.
+			*
+			*	@return The allocated storage.
+			*/
+			T*		allocate(std::size_t count)				noexcept;
+
+			/**
+			*	@brief Release storage allocated by allocate.
+			*
+			*	@param pointer	The storage to release.
+			*	@param count	Number of objects the storage has been allocated for.
+			*/
+			void	deallocate(T*			pointer,
+							   std::size_t	count)			noexcept;
+
+			template <typename U>
+			bool operator==(TaskAllocator<U> const&) const	noexcept;
+
+			template <typename U>
+			bool operator!=(TaskAllocator<U> const&) const	noexcept;
+	};
+
+	#include "Kodgen/Threading/TaskAllocator.inl"
+}
\ No newline at end of file
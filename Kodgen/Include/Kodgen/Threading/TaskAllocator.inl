@@ -0,0 +1,53 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+template <typename T>
+template <typename U>
+TaskAllocator<T>::TaskAllocator(TaskAllocator<U> const&) noexcept
+{
+}
+
+template <typename T>
+T* TaskAllocator<T>::allocate(std::size_t count) noexcept
+{
+	//Pool blocks are not aligned enough for over-aligned types
+	if constexpr (alignof(T) > TaskBlockPool::blockAlignment)
+	{
+		return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{alignof(T)}));
+	}
+	else
+	{
+		return static_cast<T*>(TaskBlockPool::allocate(count * sizeof(T)));
+	}
+}
+
+template <typename T>
+void TaskAllocator<T>::deallocate(T* pointer, std::size_t count) noexcept
+{
+	if constexpr (alignof(T) > TaskBlockPool::blockAlignment)
+	{
+		::operator delete(pointer, std::align_val_t{alignof(T)});
+	}
+	else
+	{
+		TaskBlockPool::deallocate(pointer, count * sizeof(T));
+	}
+}
+
+template <typename T>
+template <typename U>
+bool TaskAllocator<T>::operator==(TaskAllocator<U> const&) const noexcept
+{
+	return true;
+}
+
+template <typename T>
+template <typename U>
+bool TaskAllocator<T>::operator!=(TaskAllocator<U> const&) const noexcept
+{
+	return false;
+}
\ No newline at end of file
@@ -8,18 +8,80 @@
 #pragma once
 
 #include <vector>
-#include <string>
 #include <memory>	//std::shared_ptr
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+#include "Kodgen/Threading/ETaskPriority.h"
 
 namespace kodgen
 {
+	//Forward declaration
+	class TaskGroup;
+
 	class TaskBase
 	{
 		friend class TaskHelper;
+		friend class ThreadPool;
+		friend class TaskGroup;
 
 		private:
-			/** Name of the task. */
-			std::string	_name;
+			/** Name of the task. It is not copied, so it must outlive the task, which string literals do. */
+			char const*								_name;
+
+			/** Tasks depending on this task which are not ready yet. The thread pool queues them once this task completed. */
+			std::vector<std::shared_ptr<TaskBase>>	_successors;
+
+			/** Has this task completed? No successor can be registered once it has. */
+			bool									_isCompleted				= false;
+
+			/** Mutex protecting _successors and _isCompleted. */
+			std::mutex								_successorsMutex;
+
+			/** Condition notified when this task completed, used by the threads waiting for its result. */
+			std::condition_variable					_completionCondition;
+
+			/** Number of dependencies which have not completed yet. The task is queued when it reaches 0. */
+			std::atomic_size_t						_pendingDependencyCount		= 0u;
+
+			/** Reference keeping this task alive while it is in the injection queue of a thread pool. */
+			std::shared_ptr<TaskBase>				_injectedReference;
+
+			/** Task submitted before this task in the injection queue of a thread pool. */
+			TaskBase*								_nextInjectedTask			= nullptr;
+
+			/** Group this task has been submitted to, nullptr if it has been submitted to a thread pool directly. */
+			TaskGroup*								_group						= nullptr;
+
+			/** Priority of this task among the ready tasks of the thread pool. */
+			ETaskPriority							_priority					= ETaskPriority::Normal;
+
+			/** Time this task has been queued by the thread pool, once all its dependencies completed. */
+			std::chrono::steady_clock::time_point	_readyTime;
+
+			/**
+			*	@brief Register a task to queue once this task completed.
+			*
+			*	@param successor The task depending on this task.
+			*
+			*	@return true if the successor has been registered, false if this task already completed.
+			*/
+			bool									addSuccessor(std::shared_ptr<TaskBase> const& successor)	noexcept;
+
+			/**
+			*	@brief Mark this task as completed.
+			*
+			*	@return The successors of this task, which have one less pending dependency.
+			*/
+			std::vector<std::shared_ptr<TaskBase>>	complete()													noexcept;
+
+			/**
+			*	@brief	Wait until this task completed, either because it has been executed or because the thread pool discarded it.
+			*			The calling thread sleeps meanwhile, so this task must be run by another thread.
+			*/
+			void									waitForCompletion()											noexcept;
 
 		protected:
 			/** Dependent tasks which must terminate before this task is executed. */
@@ -29,8 +91,8 @@ namespace kodgen
 			TaskBase()														= delete;
 			TaskBase(char const*								name,
 					 std::vector<std::shared_ptr<TaskBase>>&&	deps = {})	noexcept;
-			TaskBase(TaskBase const&)										= default;
-			TaskBase(TaskBase&&)											= default;
+			TaskBase(TaskBase const&)										= delete;
+			TaskBase(TaskBase&&)											= delete;
 			virtual ~TaskBase()												= default;
 
 			/**
@@ -53,14 +115,29 @@ namespace kodgen
 			*/
 			virtual bool		hasFinished()		const	noexcept = 0;
 
+			/**
+			*	@brief	Add a dependency to a task created by ThreadPool::createTask, so that dependencies known after the task creation
+			*			can still be expressed. The task must not have been submitted yet.
+			*
+			*	@param dependency Task which must terminate before this task is executed. It doesn't need to be submitted yet.
+			*/
+			void				addDependency(std::shared_ptr<TaskBase> dependency)	noexcept;
+
 			/**
 			*	@brief Getter for _name field.
 			* 
-			*	@return _name field.
+			*	@return _name field, an empty string if the task has been submitted without name.
+			*/
+			char const*			getName()			const	noexcept;
+
+			/**
+			*	@brief Getter for _priority field.
+			* 
+			*	@return _priority field.
 			*/
-			std::string const&	getName()			const	noexcept;
+			ETaskPriority		getPriority()		const	noexcept;
 
-			TaskBase& operator=(TaskBase const&)	= default;
-			TaskBase& operator=(TaskBase&&)			= default;
+			TaskBase& operator=(TaskBase const&)	= delete;
+			TaskBase& operator=(TaskBase&&)			= delete;
 	};
 }
\ No newline at end of file
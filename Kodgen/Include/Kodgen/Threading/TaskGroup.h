@@ -0,0 +1,127 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <vector>
+#include <memory>				//std::shared_ptr
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>			//std::min
+#include <cassert>
+
+#include "Kodgen/Threading/ThreadPool.h"
+
+namespace kodgen
+{
+	/**
+	*	Tasks submitted to a thread pool which can be waited for without waiting for the other tasks of the pool.
+	*	Tasks of the group can submit new tasks to the group, the group is then only complete once these tasks completed as well.
+	*	A group must be waited for before the thread pool is destroyed.
+	*/
+	class TaskGroup
+	{
+		friend class ThreadPool;
+
+		private:
+			/** Thread pool running the tasks of this group. */
+			ThreadPool&				_threadPool;
+
+			/** Number of submitted tasks which have not completed yet. */
+			std::atomic_size_t		_pendingTaskCount	= 0u;
+
+			/** Mutex protecting the completion of a task, so that the group is not destroyed while a completed task notifies it. */
+			std::mutex				_mutex;
+
+			/** Condition used to notify waiting threads that all the tasks of the group completed. */
+			std::condition_variable	_condition;
+
+			/**
+			*	@brief Called by the thread pool each time a task of the group completed.
+			*/
+			void						onTaskCompleted()											noexcept;
+
+		public:
+			explicit TaskGroup(ThreadPool& threadPool)												noexcept;
+			TaskGroup(TaskGroup const&)																= delete;
+			TaskGroup(TaskGroup&&)																	= delete;
+
+			/**
+			*	Wait for the tasks of the group to complete.
+			*/
+			~TaskGroup()																			noexcept;
+
+			/**
+			*	@brief Submit a task to the thread pool as part of this group.
+			*
+			*	@param taskName	Name of the task. It is not copied, so it must be a string literal or outlive the task. Can be nullptr.
+			*	@param callable	Callable the submitted task should execute. It must take a TaskBase* as parameter.
+			*	@param deps		Dependencies of the submitted task. They don't need to be part of the group.
+			*	@param priority	Priority of the submitted task among the ready tasks.
+			*
+			*	@return A pointer to the submitted task. It can be used as a dependency when submitting other tasks.
+			*/
+			template <typename Callable, typename = decltype(std::declval<Callable>()(std::declval<TaskBase*>()))>
+			std::shared_ptr<TaskBase>	submitTask(char const*								taskName,
+												   Callable&&								callable,
+												   std::vector<std::shared_ptr<TaskBase>>&& deps		= {},
+												   ETaskPriority							priority	= ETaskPriority::Normal)	noexcept;
+
+			/**
+			*	@brief Same as submitTask, but the name is copied in the task.
+			*
+			*	@param taskName	Name of the task.
+			*	@param callable	Callable the submitted task should execute. It must take a TaskBase* as parameter.
+			*	@param deps		Dependencies of the submitted task. They don't need to be part of the group.
+			*	@param priority	Priority of the submitted task among the ready tasks.
+			*
+			*	@return A pointer to the submitted task. It can be used as a dependency when submitting other tasks.
+			*/
+			template <typename Callable, typename = decltype(std::declval<Callable>()(std::declval<TaskBase*>()))>
+			std::shared_ptr<TaskBase>	submitTask(std::string const&						taskName,
+												   Callable&&								callable,
+												   std::vector<std::shared_ptr<TaskBase>>&& deps		= {},
+												   ETaskPriority							priority	= ETaskPriority::Normal)	noexcept;
+
+			/**
+			*	@brief Submit tasks created by ThreadPool::createTask at once as part of this group, as ThreadPool::submitTasks does.
+			*
+			*	@param tasks The tasks to submit. A task must be submitted only once.
+			*/
+			void						submitTasks(std::vector<std::shared_ptr<TaskBase>> const& tasks)	noexcept;
+
+			/**
+			*	@brief	Call a function for each index of a range, split in tasks of grainSize indices submitted at once to this group.
+			*			The function is copied in each task. Call wait to wait for all the indices to be processed.
+			*			A range of at most grainSize indices is processed directly by the calling thread.
+			*
+			*	@param begin		First index of the range.
+			*	@param end			Index following the last index of the range.
+			*	@param grainSize	Maximum number of indices processed by a single task. Must not be 0.
+			*	@param function		Function to call for each index. It must take a size_t as parameter.
+			*/
+			template <typename Function>
+			void						parallelFor(size_t		begin,
+													size_t		end,
+													size_t		grainSize,
+													Function&&	function)							noexcept;
+
+			/**
+			*	@brief	Wait until all the tasks of the group completed. The thread pool must be running.
+			*			The calling thread runs queued tasks of the pool, which are not necessarily tasks of the group, until none is left.
+			*			It then sleeps until the group completed, unless it is a worker of the pool in which case it keeps looking for tasks
+			*			so that workers waiting for groups can't starve the pool.
+			*/
+			void						wait()														noexcept;
+
+			TaskGroup& operator=(TaskGroup const&)	= delete;
+			TaskGroup& operator=(TaskGroup&&)		= delete;
+	};
+
+	#include "Kodgen/Threading/TaskGroup.inl"
+}
\ No newline at end of file
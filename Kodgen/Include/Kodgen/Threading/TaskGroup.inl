@@ -0,0 +1,73 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+template <typename Callable, typename>
+std::shared_ptr<TaskBase> TaskGroup::submitTask(char const* taskName, Callable&& callable, std::vector<std::shared_ptr<TaskBase>>&& deps, ETaskPriority priority) noexcept
+{
+	std::shared_ptr<TaskBase> newTask = ThreadPool::createTask(taskName, std::forward<Callable>(callable), std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps), priority);
+
+	//Count the task before it is submitted so that the group never sees it complete before it is counted
+	newTask->_group = this;
+	_pendingTaskCount.fetch_add(1u);
+
+	_threadPool.addTask(newTask);
+
+	return newTask;
+}
+
+template <typename Callable, typename>
+std::shared_ptr<TaskBase> TaskGroup::submitTask(std::string const& taskName, Callable&& callable, std::vector<std::shared_ptr<TaskBase>>&& deps, ETaskPriority priority) noexcept
+{
+	std::shared_ptr<TaskBase> newTask = ThreadPool::createTask(taskName, std::forward<Callable>(callable), std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps), priority);
+
+	newTask->_group = this;
+	_pendingTaskCount.fetch_add(1u);
+
+	_threadPool.addTask(newTask);
+
+	return newTask;
+}
+
+template <typename Function>
+void TaskGroup::parallelFor(size_t begin, size_t end, size_t grainSize, Function&& function) noexcept
+{
+	assert(grainSize != 0u);
+
+	if (begin >= end)
+	{
+		return;
+	}
+
+	//A range fitting in a single task is processed directly by the current thread
+	if (end - begin <= grainSize)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			function(i);
+		}
+
+		return;
+	}
+
+	std::vector<std::shared_ptr<TaskBase>> tasks;
+	tasks.reserve((end - begin - 1u) / grainSize + 1u);
+
+	for (size_t rangeBegin = begin; rangeBegin < end; rangeBegin += std::min(grainSize, end - rangeBegin))
+	{
+		size_t rangeEnd = rangeBegin + std::min(grainSize, end - rangeBegin);
+
+		tasks.emplace_back(ThreadPool::createTask("Parallel for", [function, rangeBegin, rangeEnd](TaskBase*) mutable
+												  {
+													  for (size_t i = rangeBegin; i < rangeEnd; i++)
+													  {
+														  function(i);
+													  }
+												  }));
+	}
+
+	submitTasks(tasks);
+}
\ No newline at end of file
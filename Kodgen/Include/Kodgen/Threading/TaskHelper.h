@@ -7,7 +7,8 @@
 
 #pragma once
 
-#include <type_traits>	//std::enable_if_t
+#include <type_traits>	//std::enable_if_t, std::is_void_v
+#include <future>		//std::future_error
 #include <cassert>
 
 #include "Kodgen/Threading/Task.h"
@@ -21,13 +22,19 @@ namespace kodgen
 			~TaskHelper() = delete;
 
 			/**
-			*	@brief Retrieve the result from a TaskBase object
+			*	@brief	Retrieve the result from a TaskBase object, waiting for the task to finish executing if it has not yet.
+			*			The result is moved out of the task, so it can only be retrieved once.
+			*			For tasks returning void, only propagate the exception thrown by the task, if any.
 			*	
-			*	@param task The task we get the result from.
+			*	@param task The task we get the result from. If it has not finished executing, it must have been submitted to a thread pool
+			*				which will run it on another thread.
+			*
+			*	@exception Any exception propagated from the task execution.
+			*	@exception std::future_error with the std::future_errc::broken_promise code if the thread pool has been destroyed before running the task.
 			*
 			*	@return The result of the provided task.
 			*/
-			template <typename ResultType, typename = typename std::enable_if_t<!std::is_same_v<ResultType, void>>>
+			template <typename ResultType>
 			static ResultType getResult(TaskBase* task);
 
 			/**
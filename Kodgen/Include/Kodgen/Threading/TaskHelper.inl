@@ -5,13 +5,33 @@
 *	See the LICENSE.md file for full license details.
 */
 
-template <typename ResultType, typename>
+template <typename ResultType>
 ResultType TaskHelper::getResult(TaskBase* task)
 {
 	assert(task != nullptr);
-	assert(reinterpret_cast<Task<ResultType>*>(task)->_result.valid());
 
-	return reinterpret_cast<Task<ResultType>*>(task)->_result.get();
+	Task<ResultType>* typedTask = static_cast<Task<ResultType>*>(task);
+
+	if (!typedTask->hasFinished())
+	{
+		typedTask->waitForCompletion();
+
+		//The thread pool has been destroyed before running the task
+		if (!typedTask->hasFinished())
+		{
+			throw std::future_error(std::future_errc::broken_promise);
+		}
+	}
+
+	if (typedTask->_exception != nullptr)
+	{
+		std::rethrow_exception(typedTask->_exception);
+	}
+
+	if constexpr (!std::is_void_v<ResultType>)
+	{
+		return std::move(*typedTask->_result);
+	}
 }
 
 template <typename ResultType, typename>
@@ -8,94 +8,385 @@
 #pragma once
 
 #include <string>
-#include <list>
+#include <deque>
 #include <vector>
 #include <thread>
+#include <array>
 #include <condition_variable>
 #include <mutex>
 #include <atomic>		//std::atomic_uint
 #include <functional>	//std::bind
 #include <memory>		//std::shared_ptr
 #include <type_traits>	//std::invoke_result
+#include <chrono>
 
 #include "Kodgen/Threading/Task.h"
+#include "Kodgen/Threading/TaskAllocator.h"
 #include "Kodgen/Threading/ETerminationMode.h"
+#include "Kodgen/Threading/ETaskPriority.h"
+#include "Kodgen/Threading/ThreadPoolStatistics.h"
 #include "Kodgen/Misc/FundamentalTypes.h"
 
 namespace kodgen
 {
+	//Forward declaration
+	class TaskGroup;
+
+	/**
+	*	Work-stealing thread pool.
+	*	Tasks are queued once all their dependencies completed, so queues only contain ready tasks. Each worker owns a queue containing
+	*	the tasks it submitted and the tasks made ready by the tasks it ran. Tasks submitted from outside of the pool are pushed to
+	*	a lock-free injection queue, moved to the queue of the first worker looking for work. Workers with an empty queue steal tasks
+	*	from the queues of the other workers, so workers only compete for a queue when stealing from it.
+	*	Tasks are taken in submission order, both from the own queue and when stealing, since submitters rely on the submission order
+	*	to run the most expensive tasks first. Tasks made ready by a completed task are run first by the worker which completed it.
+	*	Each queue is split by task priority: a worker looking for a task takes the ready tasks of the highest priority first,
+	*	stealing them if needed, before it considers any task of a lower priority.
+	*	The number of workers can change at runtime, up to the maximum number of workers the pool has been created with: the queue
+	*	of each possible worker exists for the whole pool lifetime, so that workers can come and go while others steal from them.
+	*/
 	class ThreadPool
 	{
+		friend class TaskGroup;
+
 		private:
+			/** Number of task priorities. */
+			static constexpr size_t const	_priorityCount = static_cast<size_t>(ETaskPriority::Count);
+
+			/** Tasks queue owned by a worker. */
+			struct WorkerQueue
+			{
+				/** Queued ready tasks of each priority. */
+				std::array<std::deque<std::shared_ptr<TaskBase>>, _priorityCount>	tasks;
+
+				/** Mutex protecting tasks. It is only contended when other workers steal from this queue. */
+				std::mutex															mutex;
+
+				/** Number of queued tasks of each priority, so that thieves skip empty queues without locking them. */
+				std::array<std::atomic_size_t, _priorityCount>						sizes	= {};
+			};
+
+			/**
+			*	Activity counters of a thread running tasks, aligned so that threads updating their counters don't share cache lines.
+			*	Counters are only read to build statistics, so they are updated with relaxed operations. Durations are in nanoseconds.
+			*/
+			struct alignas(64) WorkerCounters
+			{
+				/** Time spent executing tasks. */
+				std::atomic<uint64>	busyDuration		= 0u;
+
+				/** Time spent sleeping while waiting for tasks. */
+				std::atomic<uint64>	idleDuration		= 0u;
+
+				/** Number of executed tasks. */
+				std::atomic<uint64>	executedTaskCount	= 0u;
+
+				/** Number of tasks taken from the queue of another worker. */
+				std::atomic<uint64>	stolenTaskCount		= 0u;
+
+				/** Number of times a queue was already locked when taking a task from it. */
+				std::atomic<uint64>	contendedLockCount	= 0u;
+
+				/** Sum of the durations the executed tasks waited between becoming ready and starting. */
+				std::atomic<uint64>	taskWaitDuration	= 0u;
+			};
+
+			/** Pool the current thread is a worker of, nullptr if the current thread is not a worker. */
+			static thread_local ThreadPool*					_currentWorkerPool;
+
+			/** Index of the current thread in the workers of _currentWorkerPool. */
+			static thread_local uint32						_currentWorkerIndex;
+
 			/** Are workers allowed to process queued tasks? */
-			bool									_isRunning	= true;
+			std::atomic_bool								_isRunning			= true;
+
+			/** Thread of each possible worker of this pool. A thread is not joinable until a worker has been spawned with its index. */
+			std::vector<std::thread>						_workers;
+
+			/** Is a worker running with each index? */
+			std::vector<bool>								_isWorkerAlive;
+
+			/** Mutex protecting _workers and _isWorkerAlive. */
+			std::mutex										_workersMutex;
 
-			/** Collection of all workers in this pool. */
-			std::vector<std::thread>				_workers;
+			/** Queue of each possible worker, in the _workers order. */
+			std::vector<std::unique_ptr<WorkerQueue>>		_workerQueues;
 
-			/** List of all tasks. */
-			std::list<std::shared_ptr<TaskBase>>	_tasks;
+			/** Counters of each possible worker, in the _workers order, followed by the counters of the threads which are not workers. */
+			std::unique_ptr<WorkerCounters[]>				_workerCounters;
+
+			/** Number of workers the pool should have. Workers with a higher index exit once they finished their current task. */
+			std::atomic_uint								_targetWorkerCount	= 0u;
+
+			/** Number of running workers, sleeping or not. */
+			std::atomic_uint								_liveWorkerCount	= 0u;
+
+			/** Time after which a sleeping worker exits, 0 if workers never exit while sleeping. Protected by _taskMutex. */
+			std::chrono::milliseconds						_idleTimeout		= std::chrono::milliseconds(0);
+
+			/**
+			*	Last task submitted from outside of the pool which has not been moved to a worker queue yet.
+			*	Injected tasks are linked through their _nextInjectedTask field, so that injecting a task doesn't allocate.
+			*/
+			std::atomic<TaskBase*>							_injectedTasks		= nullptr;
+
+			/** Number of queued ready tasks which have not been taken by a worker yet. */
+			std::atomic_size_t								_queuedTaskCount	= 0u;
+
+			/** Number of queued ready tasks of each priority, so that workers skip the priorities without any queued task. */
+			std::array<std::atomic_size_t, _priorityCount>	_queuedTaskCounts	= {};
+
+			/** Are statistics collected? Reading the clock for each task is not free, so they are only collected on demand. */
+			std::atomic_bool								_isCollectingStatistics	= false;
+
+			/** Highest value _queuedTaskCount reached since the statistics have been reset. */
+			std::atomic<uint64>								_maxQueuedTaskCount		= 0u;
 
 			/** Set to true when the ThreadPool destructor has been called. */
-			bool									_destructorCalled	= false;
+			std::atomic_bool								_destructorCalled	= false;
+
+			/** Condition used to notify sleeping workers there are tasks to proceed. */
+			std::condition_variable							_taskCondition;
+
+			/** Condition used to notify joining threads that a worker went to sleep. */
+			std::condition_variable							_joinCondition;
 
-			/** Condition used to notify workers there are tasks to proceed. */
-			std::condition_variable					_taskCondition;
+			/** Mutex used with taskCondition and joinCondition. */
+			std::mutex										_taskMutex;
 
-			/** Mutex used with taskCondition. */
-			std::mutex								_taskMutex;
+			/** Number of running workers which are not sleeping. */
+			std::atomic_uint								_workingWorkers		= 0u;
 
-			/** Number of workers currently running a task. */
-			std::atomic_uint						_workingWorkers;
+			/** Number of workers looking for a task in the queues. */
+			std::atomic_uint								_searchingWorkers	= 0u;
 
 			/**
 			*	@brief Routine run by workers.
+			*
+			*	@param workerIndex Index of the worker running the routine.
+			*/
+			void						workerRoutine(uint32 workerIndex)		noexcept;
+
+			/**
+			*	@brief Make a worker sleep until it has something to do.
+			*
+			*	@param lock			Lock owning _taskMutex.
+			*	@param workerIndex	Index of the sleeping worker.
+			*
+			*	@return false if the worker slept for longer than the idle timeout and must exit, else true.
 			*/
-			void						workerRoutine()				noexcept;
+			bool						waitForTasks(std::unique_lock<std::mutex>&	lock,
+													 uint32							workerIndex)	noexcept;
 
 			/**
-			*	@brief	Retrieve a task which is ready to execute.
-			*			This method doesn't lock the task mutex so make sure _tasks is safe to access BEFORE the method is called.
+			*	@brief Spawn workers until the pool has the target number of workers, unless the pool is being destroyed.
+			*/
+			void						spawnWorkers()								noexcept;
+
+			/**
+			*	@brief	Retrieve a task of the highest priority any task is queued with, from the worker own queue first,
+			*			then from the injection queue, then from the other workers queues.
+			*
+			*	@param workerIndex Index of the worker looking for a task.
 			*	
 			*	@return A valid shared_ptr pointing to a ready-to-execute task if any, else an empty shared_ptr.
 			*/
-			std::shared_ptr<TaskBase>	getTask()					noexcept;
+			std::shared_ptr<TaskBase>	getTask(uint32 workerIndex)				noexcept;
 
 			/**
-			*	@brief Check whether a worker should keep running or terminate.
+			*	@brief Remove the first task of a priority from a worker queue.
+			*
+			*	@param queue	The queue to take a task from.
+			*	@param priority	Index of the priority of the task to take.
 			*	
-			*	@return true if the worker should continue to poll new tasks, else false.
+			*	@return A valid shared_ptr pointing to a ready-to-execute task if any, else an empty shared_ptr.
+			*/
+			std::shared_ptr<TaskBase>	popTask(WorkerQueue&	queue,
+												size_t			priority)			noexcept;
+
+			/**
+			*	@brief Move all the tasks of the injection queue to the back of a worker queue, in submission order.
+			*
+			*	@param queue The queue to move the tasks to.
+			*/
+			void						takeInjectedTasks(WorkerQueue& queue)	noexcept;
+
+			/**
+			*	@brief Append a chain of tasks linked like the injection queue to the back of a worker queue, in submission order.
+			*
+			*	@param queue	The queue to append the tasks to.
+			*	@param lastTask	Last submitted task of the chain.
+			*/
+			void						appendTaskChain(WorkerQueue&	queue,
+														TaskBase*		lastTask)		noexcept;
+
+			/**
+			*	@brief Register a submitted task as a successor of its dependencies.
+			*
+			*	@param task The submitted task.
+			*
+			*	@return true if all the dependencies of the task already completed, in which case the caller must queue it.
+			*/
+			bool						registerTask(std::shared_ptr<TaskBase> const& task)	noexcept;
+
+			/**
+			*	@brief	Register a submitted task as a successor of its dependencies.
+			*			The task is queued right away if all its dependencies already completed.
+			*
+			*	@param task The submitted task.
+			*/
+			void						addTask(std::shared_ptr<TaskBase> task)		noexcept;
+
+			/**
+			*	@brief Queue a ready task and wake a sleeping worker up if needed.
+			*
+			*	@param task			The ready task.
+			*	@param isSuccessor	Has the task been made ready by a task completed by the current worker? It is then run next by this worker.
+			*/
+			void						pushTask(std::shared_ptr<TaskBase>	task,
+												 bool						isSuccessor)	noexcept;
+
+			/**
+			*	@brief Execute a task, then queue its successors which don't have any pending dependency left.
+			*
+			*	@param task The task to execute.
+			*/
+			void						executeTask(TaskBase& task)					noexcept;
+
+			/**
+			*	@brief	Take a queued task and execute it on the current thread, as the current worker if the current thread is a worker
+			*			of this pool, else as the first worker. Tasks are only taken while the pool is running.
+			*
+			*	@return true if a task has been executed, false if no task could be taken.
+			*/
+			bool						runQueuedTask()								noexcept;
+
+			/**
+			*	@brief Getter for the counters of the current thread.
+			*
+			*	@return The counters of the current worker if the current thread is a worker of this pool, else the counters of the threads which are not workers.
+			*/
+			WorkerCounters&				getCurrentCounters()						noexcept;
+
+			/**
+			*	@brief Update the highest number of queued tasks after tasks have been queued.
+			*
+			*	@param queuedTaskCount Number of queued tasks once the tasks have been queued.
+			*/
+			void						updateMaxQueuedTaskCount(uint64 queuedTaskCount)	noexcept;
+
+			/**
+			*	@brief	Wake a sleeping worker up if there are queued tasks and no worker is already looking for them.
+			*			If no worker is sleeping and workers exited because they were idle, spawn them again instead.
+			*			Workers looking for a task check the queued task count before sleeping, so they never miss a task.
 			*/
-			bool						shouldKeepRunning()	const	noexcept;
+			void						wakeWorker()								noexcept;
 
 		public:
 			/** Termination mode to apply when this Thread pool will be destroyed. */
 			ETerminationMode	terminationMode = ETerminationMode::FinishAll;
 
+			/**
+			*	@param threadCount		Number of worker threads to spawn. If 0 is provided, no thread is spawned and tasks are run by
+			*							the threads joining the pool or waiting for a group, and by the destructor in FinishAll mode.
+			*	@param terminationMode	Termination mode to apply when this thread pool is destroyed.
+			*	@param maxThreadCount	Maximum number of worker threads setWorkerCount can grow the pool to. It is at least threadCount.
+			*/
 			ThreadPool(uint32			threadCount		= std::thread::hardware_concurrency(),
-					   ETerminationMode	terminationMode = ETerminationMode::FinishAll)			noexcept;
+					   ETerminationMode	terminationMode = ETerminationMode::FinishAll,
+					   uint32			maxThreadCount	= std::thread::hardware_concurrency())	noexcept;
 			ThreadPool(ThreadPool const&)														= delete;
 			ThreadPool(ThreadPool&&)															= delete;
 			~ThreadPool()																		noexcept;
 
 			/**
-			*	@brief Submit a task to the thread pool.
+			*	@brief	Submit a task to the thread pool.
+			*			The task and its callable are allocated at once from the TaskBlockPool, so submitting a task doesn't allocate
+			*			once the pool is warm, apart from the dependencies vector.
+			*	
+			*	@param taskName	Name of the task to submit to the thread pool. It is not copied, so it must be a string literal
+			*					or outlive the task. Can be nullptr.
+			*	@param callable	Callable the submitted task should execute. It must take a TaskBase* as parameter.
+			*	@param deps		Dependencies of the submitted task.
+			*	@param priority	Priority of the submitted task among the ready tasks.
+			*
+			*	@return A pointer to the submitted task. It can be used as a dependency when submitting other tasks.
+			*/
+			template <typename Callable, typename = decltype(std::declval<Callable>()(std::declval<TaskBase*>()))>
+			std::shared_ptr<TaskBase>	submitTask(char const*								taskName,
+												   Callable&&								callable,
+												   std::vector<std::shared_ptr<TaskBase>>&& deps		= {},
+												   ETaskPriority							priority	= ETaskPriority::Normal)	noexcept;
+
+			/**
+			*	@brief Same as submitTask, but the name is copied in the task.
 			*	
 			*	@param taskName	Name of the task to submit to the thread pool.
 			*	@param callable	Callable the submitted task should execute. It must take a TaskBase* as parameter.
 			*	@param deps		Dependencies of the submitted task.
+			*	@param priority	Priority of the submitted task among the ready tasks.
 			*
 			*	@return A pointer to the submitted task. It can be used as a dependency when submitting other tasks.
 			*/
 			template <typename Callable, typename = decltype(std::declval<Callable>()(std::declval<TaskBase*>()))>
 			std::shared_ptr<TaskBase>	submitTask(std::string const&						taskName,
 												   Callable&&								callable,
-												   std::vector<std::shared_ptr<TaskBase>>&& deps = {})	noexcept;
+												   std::vector<std::shared_ptr<TaskBase>>&& deps		= {},
+												   ETaskPriority							priority	= ETaskPriority::Normal)	noexcept;
+
+			/**
+			*	@brief	Create a task without submitting it, so that it can be submitted later with other tasks by submitTasks.
+			*			The task is allocated like a task submitted by submitTask.
+			*	
+			*	@param taskName	Name of the task. It is not copied, so it must be a string literal or outlive the task. Can be nullptr.
+			*	@param callable	Callable the task should execute. It must take a TaskBase* as parameter.
+			*	@param deps		Dependencies of the task. They can be tasks which have not been submitted yet.
+			*	@param priority	Priority of the task among the ready tasks.
+			*
+			*	@return A pointer to the created task.
+			*/
+			template <typename Callable, typename = decltype(std::declval<Callable>()(std::declval<TaskBase*>()))>
+			static std::shared_ptr<TaskBase>	createTask(char const*								taskName,
+														   Callable&&								callable,
+														   std::vector<std::shared_ptr<TaskBase>>&& deps		= {},
+														   ETaskPriority							priority	= ETaskPriority::Normal)	noexcept;
 
 			/**
-			*	@brief Join all workers.
+			*	@brief Same as createTask, but the name is copied in the task.
+			*	
+			*	@param taskName	Name of the task.
+			*	@param callable	Callable the task should execute. It must take a TaskBase* as parameter.
+			*	@param deps		Dependencies of the task. They can be tasks which have not been submitted yet.
+			*	@param priority	Priority of the task among the ready tasks.
+			*
+			*	@return A pointer to the created task.
 			*/
-			void						joinWorkers()													noexcept;
+			template <typename Callable, typename = decltype(std::declval<Callable>()(std::declval<TaskBase*>()))>
+			static std::shared_ptr<TaskBase>	createTask(std::string const&						taskName,
+														   Callable&&								callable,
+														   std::vector<std::shared_ptr<TaskBase>>&& deps		= {},
+														   ETaskPriority							priority	= ETaskPriority::Normal)	noexcept;
+
+			/**
+			*	@brief	Submit tasks created by createTask at once.
+			*			The tasks which are ready are queued together, in order, with a single queue lock or a single push to
+			*			the injection queue, and no worker can take any of them before they are all submitted.
+			*			A task can depend on the tasks following it in the vector.
+			*
+			*	@param tasks The tasks to submit. A task must be submitted only once.
+			*/
+			void						submitTasks(std::vector<std::shared_ptr<TaskBase>> const& tasks)	noexcept;
+
+			/**
+			*	@brief	Wait until all workers are asleep, with no queued task left if the pool is running.
+			*			The calling thread sleeps while it waits instead of spinning.
+			*
+			*	@param runQueuedTasks	Should the calling thread run queued tasks as an additional worker before it waits?
+			*							It then takes tasks like the first worker, but the tasks submitted by the tasks it runs
+			*							go to the injection queue since it doesn't own any queue.
+			*							Always true for a pool without worker.
+			*/
+			void						joinWorkers(bool runQueuedTasks = false)						noexcept;
 
 			/**
 			*	@brief Allow or disallow workers to process tasks.
@@ -104,6 +395,74 @@ namespace kodgen
 			*/
 			void						setIsRunning(bool isRunning)									noexcept;
 
+			/**
+			*	@brief	Change the number of worker threads of this pool. It can be called at any time, including while tasks run.
+			*			New workers are spawned right away. Removed workers exit once they finished their current task, and the tasks
+			*			left in their queue are run by the remaining workers, or by the threads joining the pool if no worker is left.
+			*
+			*	@param workerCount New number of worker threads. It is clamped to the maximum number of workers of this pool.
+			*/
+			void						setWorkerCount(uint32 workerCount)								noexcept;
+
+			/**
+			*	@brief	Make the workers exit when they have nothing to do for some time, so that an idle pool doesn't keep threads alive.
+			*			Workers which exited are spawned again, up to the worker count, as soon as tasks are queued.
+			*
+			*	@param idleTimeout Time after which a sleeping worker exits, or 0 to keep sleeping workers alive.
+			*/
+			void						setIdleTimeout(std::chrono::milliseconds idleTimeout)			noexcept;
+
+			/**
+			*	@brief	Make all the workers exit once they finished their current task, and join their threads.
+			*			The worker count is kept: workers are spawned again as soon as tasks are queued, like idle workers.
+			*			Call it before forking the process, so that no worker holds a lock the child process would need.
+			*/
+			void						stopWorkers()													noexcept;
+
+			/**
+			*	@brief Getter for the number of worker threads of this pool, including the workers which exited because they were idle.
+			*
+			*	@return The number of worker threads of this pool.
+			*/
+			uint32						getWorkerCount()										const	noexcept;
+
+			/**
+			*	@brief	Enable or disable the collection of statistics. Statistics are not collected by default.
+			*			Tasks which became ready while statistics were not collected are not accounted in the average task wait duration.
+			*
+			*	@param isCollectingStatistics true to collect statistics, else false.
+			*/
+			void						setIsCollectingStatistics(bool isCollectingStatistics)			noexcept;
+
+			/**
+			*	@brief	Take a snapshot of the activity of this pool while statistics were collected, since it has been created or since
+			*			resetStatistics has been called. It can be called while tasks run, the counters of the running tasks are then not updated yet.
+			*
+			*	@return The statistics of this pool.
+			*/
+			ThreadPoolStatistics		getStatistics()											const	noexcept;
+
+			/**
+			*	@brief	Reset the statistics of this pool, so that the next snapshot only covers the activity following this call.
+			*			Tasks running during the call may be partially accounted in the next snapshot.
+			*/
+			void						resetStatistics()												noexcept;
+
+			/**
+			*	@brief	Getter for the index of the current thread among the workers of this pool, so that tasks can keep per-worker state.
+			*			Threads which are not workers of this pool, like threads joining the pool or waiting for a group, all get the same index.
+			*
+			*	@return The index of the current worker, or getMaxWorkerCount() if the current thread is not a worker of this pool.
+			*/
+			uint32						getCurrentWorkerIndex()									const	noexcept;
+
+			/**
+			*	@brief Getter for the maximum number of worker threads of this pool.
+			*
+			*	@return The maximum number of worker threads of this pool.
+			*/
+			uint32						getMaxWorkerCount()										const	noexcept;
+
 			ThreadPool& operator=(ThreadPool const&)	= delete;
 			ThreadPool& operator=(ThreadPool&&)			= delete;
 	};
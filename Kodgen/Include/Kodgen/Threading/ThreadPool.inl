@@ -6,21 +6,48 @@
 */
 
 template <typename Callable, typename>
-std::shared_ptr<TaskBase> ThreadPool::submitTask(std::string const& taskName, Callable&& callable, std::vector<std::shared_ptr<TaskBase>>&& deps) noexcept
+std::shared_ptr<TaskBase> ThreadPool::submitTask(char const* taskName, Callable&& callable, std::vector<std::shared_ptr<TaskBase>>&& deps, ETaskPriority priority) noexcept
+{
+	std::shared_ptr<TaskBase> newTask = createTask(taskName, std::forward<Callable>(callable), std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps), priority);
+
+	addTask(newTask);
+
+	return newTask;
+}
+
+template <typename Callable, typename>
+std::shared_ptr<TaskBase> ThreadPool::createTask(char const* taskName, Callable&& callable, std::vector<std::shared_ptr<TaskBase>>&& deps, ETaskPriority priority) noexcept
 {
 	//Return type of the submitted task
-	using ReturnType = typename std::invoke_result_t<Callable, TaskBase*>;
+	using ReturnType	= typename std::invoke_result_t<Callable, TaskBase*>;
+	using TaskType		= CallableTask<ReturnType, std::decay_t<Callable>>;
+
+	std::shared_ptr<TaskBase> newTask = std::allocate_shared<TaskType>(TaskAllocator<TaskType>(), taskName, std::forward<Callable>(callable), std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps));
 
-	std::vector<std::shared_ptr<TaskBase>> depsCopy = deps;
+	newTask->_priority = priority;
+
+	return newTask;
+}
 
-	std::shared_ptr<Task<ReturnType>> newTask =
-		std::make_shared<Task<ReturnType>>(taskName.data(), std::forward<Callable>(callable), std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps));
+template <typename Callable, typename>
+std::shared_ptr<TaskBase> ThreadPool::submitTask(std::string const& taskName, Callable&& callable, std::vector<std::shared_ptr<TaskBase>>&& deps, ETaskPriority priority) noexcept
+{
+	std::shared_ptr<TaskBase> newTask = createTask(taskName, std::forward<Callable>(callable), std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps), priority);
+
+	addTask(newTask);
+
+	return newTask;
+}
+
+template <typename Callable, typename>
+std::shared_ptr<TaskBase> ThreadPool::createTask(std::string const& taskName, Callable&& callable, std::vector<std::shared_ptr<TaskBase>>&& deps, ETaskPriority priority) noexcept
+{
+	using ReturnType	= typename std::invoke_result_t<Callable, TaskBase*>;
+	using TaskType		= NamedCallableTask<ReturnType, std::decay_t<Callable>>;
 
-	_taskMutex.lock();
-	_tasks.emplace_back(newTask);
-	_taskMutex.unlock();
+	std::shared_ptr<TaskBase> newTask = std::allocate_shared<TaskType>(TaskAllocator<TaskType>(), taskName, std::forward<Callable>(callable), std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps));
 
-	_taskCondition.notify_one();
+	newTask->_priority = priority;
 
 	return newTask;
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Activity of a thread pool while it collected statistics, since it has been created or since its statistics have been reset.
+	*/
+	class ThreadPoolStatistics
+	{
+		public:
+			/** Activity of the threads running the tasks of a thread pool. */
+			struct WorkerStatistics
+			{
+				/** Time elapsed (in seconds) executing tasks. */
+				float	busyDuration		= 0.0f;
+
+				/** Time elapsed (in seconds) sleeping while waiting for tasks. Threads which are not workers of the pool never sleep in it. */
+				float	idleDuration		= 0.0f;
+
+				/** Number of executed tasks. */
+				uint64	executedTaskCount	= 0u;
+
+				/** Number of executed tasks taken from the queue of another worker. */
+				uint64	stolenTaskCount		= 0u;
+
+				/** Number of times a queue was already locked by another thread when taking a task from it. */
+				uint64	contendedLockCount	= 0u;
+			};
+
+			/** Statistics of each possible worker of the pool, in worker index order, including the workers which exited. */
+			std::vector<WorkerStatistics>	workers;
+
+			/** Statistics of the tasks run by threads which are not workers of the pool, like threads joining the pool or waiting for a group. */
+			WorkerStatistics				externalThreads;
+
+			/** Highest number of ready tasks queued at the same time. */
+			uint64							maxQueuedTaskCount		= 0u;
+
+			/** Average time elapsed (in seconds) between the moment a task became ready and the moment it started. */
+			float							averageTaskWaitDuration	= 0.0f;
+	};
+}
\ No newline at end of file
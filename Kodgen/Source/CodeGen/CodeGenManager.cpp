@@ -1,32 +1,51 @@
 #include "Kodgen/CodeGen/CodeGenManager.h"
 
+#include <algorithm>	//std::min, std::sort, std::remove_if
+#include <cmath>		//std::abs
+#include <limits>		//std::numeric_limits
+#include <numeric>		//std::iota
+#include <sstream>		//std::istringstream
+#include <cstdio>		//std::fflush
+
+#if !_WIN32
+#include <unistd.h>		//fork, pipe, read, write, close, _exit
+#include <poll.h>		//poll
+#include <signal.h>		//kill
+#include <sys/wait.h>	//waitpid
+#include <cerrno>		//errno
+#endif
+
 #include "Kodgen/CodeGen/GeneratedFile.h"
 #include "Kodgen/Parsing/ParsingSettings.h"	//ParsingSettings::parsingMacro
 
 using namespace kodgen;
 
 CodeGenManager::CodeGenManager(uint32 threadCount) noexcept:
-	_threadPool(getThreadCount(threadCount), ETerminationMode::FinishAll)
+	//The calling thread runs tasks while it waits for them, so it is one of the threads
+	_threadPool(getThreadCount(threadCount) - 1u, ETerminationMode::FinishAll)
 {
+	//Files processing tasks are long enough for the statistics collection to be negligible
+	_threadPool.setIsCollectingStatistics(true);
 }
 
-std::set<fs::path> CodeGenManager::identifyFilesToProcess(CodeGenUnit const& codeGenUnit, CodeGenResult& out_genResult, bool forceRegenerateAll) noexcept
+void CodeGenManager::stopWatching() noexcept
 {
-	std::set<fs::path> result;
+	_isStopWatchingRequested.store(true);
+}
 
+void CodeGenManager::setIdleWorkerTimeout(std::chrono::milliseconds idleTimeout) noexcept
+{
+	_threadPool.setIdleTimeout(idleTimeout);
+}
+
+void CodeGenManager::discoverFiles(std::unordered_set<fs::path, PathHash>& out_files) noexcept
+{
 	//Iterate over all "toParseFiles"
-	for (fs::path path : settings.getToProcessFiles())
+	for (fs::path const& path : settings.getToProcessFiles())
 	{
 		if (fs::exists(path) && !fs::is_directory(path))
 		{
-			if (!codeGenUnit.isUpToDate(path) || forceRegenerateAll)
-			{
-				result.emplace(path);
-			}
-			else
-			{
-				out_genResult.upToDateFiles.push_back(path);
-			}
+			out_files.insert(FilesystemHelpers::sanitizePath(path));
 		}
 		else if (logger != nullptr)
 		{
@@ -35,48 +54,934 @@ std::set<fs::path> CodeGenManager::identifyFilesToProcess(CodeGenUnit const& cod
 		}
 	}
 
+	//Ignored paths are accessed concurrently by the discovery tasks, so they must not be lazily sanitized during the walk
+	settings.sanitizeIgnoredPaths();
+
+	std::mutex				discoveredFilesMutex;
+	std::vector<fs::path>	discoveredFiles;
+	TaskGroup				discoveryGroup(_threadPool);
+
 	//Iterate over all "toParseDirectories"
-	for (fs::path pathToIncludedDir : settings.getToProcessDirectories())
+	for (fs::path const& pathToIncludedDir : settings.getToProcessDirectories())
 	{
 		if (fs::exists(pathToIncludedDir) && fs::is_directory(pathToIncludedDir))
 		{
-			for (fs::recursive_directory_iterator directoryIt = fs::recursive_directory_iterator(pathToIncludedDir, fs::directory_options::follow_directory_symlink); directoryIt != fs::recursive_directory_iterator(); directoryIt++)
+			discoveryGroup.submitTask("Discovery", [this, directory = FilesystemHelpers::sanitizePath(pathToIncludedDir), &discoveryGroup, &discoveredFilesMutex, &discoveredFiles](TaskBase*)
+									  {
+										  discoverDirectoryFiles(directory, true, discoveryGroup, discoveredFilesMutex, discoveredFiles);
+									  });
+		}
+		else if (logger != nullptr)
+		{
+			//Add FileGenerationFile invalid path
+			logger->log("Directory " + pathToIncludedDir.string() + " is not a directory or doesn't exist. Skip.", ILogger::ELogSeverity::Warning);
+		}
+	}
+
+	//Discovery tasks submit the tasks of the subdirectories to the group, so the group completes once all directories have been walked.
+	//The current thread walks directories too instead of waiting idle.
+	discoveryGroup.wait();
+
+	//Processed directories might overlap, so some files might have been discovered multiple times
+	out_files.reserve(out_files.size() + discoveredFiles.size());
+
+	for (fs::path& file : discoveredFiles)
+	{
+		out_files.insert(std::move(file));
+	}
+}
+
+void CodeGenManager::discoverDirectoryFiles(fs::path const& directory, bool isCanonicalPath, TaskGroup& discoveryGroup, std::mutex& filesMutex, std::vector<fs::path>& out_files) noexcept
+{
+	std::vector<DirectoryEntry>	entries;
+	std::vector<fs::path>		files;
+
+	if (!FilesystemHelpers::readDirectory(directory, entries))
+	{
+		return;
+	}
+
+	std::unordered_set<std::string> const& supportedExtensions = settings.getSupportedExtensions();
+
+	for (DirectoryEntry const& entry : entries)
+	{
+		fs::path entryPath = directory / entry.name;
+
+		//Ignored paths are canonical: a path built from a canonical directory can be looked up as is,
+		//unless a symbolic link has been followed, in which case the settings canonicalize it first
+		bool isCanonicalEntryPath = isCanonicalPath && !entry.isSymlink;
+
+		if (entry.isRegularFile)
+		{
+			size_t extensionPosition = entry.name.rfind('.');
+
+			//Same rule as fs::path::extension: a leading dot doesn't start an extension
+			if (extensionPosition != std::string::npos && extensionPosition != 0u &&
+				supportedExtensions.find(entry.name.substr(extensionPosition)) != supportedExtensions.cend() &&
+				!(isCanonicalEntryPath ? settings.getIgnoredFiles().count(entryPath) != 0u : settings.isIgnoredFile(entryPath)))
 			{
-				fs::directory_entry entry = *directoryIt;
+				files.emplace_back(std::move(entryPath));
+			}
+		}
+		else if (entry.isDirectory &&
+				 !(isCanonicalEntryPath ? settings.getIgnoredDirectories().count(entryPath) != 0u : settings.isIgnoredDirectory(entryPath)))
+		{
+			discoveryGroup.submitTask("Discovery", [this, subdirectory = std::move(entryPath), isCanonicalEntryPath, &discoveryGroup, &filesMutex, &out_files](TaskBase*)
+									  {
+										  discoverDirectoryFiles(subdirectory, isCanonicalEntryPath, discoveryGroup, filesMutex, out_files);
+									  });
+		}
+	}
+
+	if (!files.empty())
+	{
+		std::lock_guard<std::mutex> lock(filesMutex);
 
-				//Just to make sure the entry hasn't been deleted since beginning of directory iteration
-				if (entry.exists())
+		out_files.insert(out_files.cend(), std::make_move_iterator(files.begin()), std::make_move_iterator(files.end()));
+	}
+}
+
+std::vector<fs::path> CodeGenManager::identifyFilesToProcess(CodeGenUnit const& codeGenUnit, std::unordered_set<fs::path, PathHash> const& candidates, CodeGenManifest const& manifest, uint64 fingerprint,
+															   std::unordered_map<fs::path, uint64, PathHash>& inout_contentHashes, bool forceRegenerateAll) noexcept
+{
+	//Hash all candidates along with all the dependencies recorded for them during the last generation
+	std::vector<fs::path> toHashFiles(candidates.cbegin(), candidates.cend());
+
+	if (!forceRegenerateAll)
+	{
+		std::unordered_set<fs::path, PathHash> dependencies;
+
+		for (fs::path const& file : candidates)
+		{
+			if (CodeGenManifest::Entry const* entry = manifest.getEntry(file))
+			{
+				for (CodeGenManifest::Dependency const& dependency : entry->dependencies)
 				{
-					if (entry.is_regular_file())
+					if (candidates.count(dependency.path) == 0u)
 					{
-						if (settings.isSupportedFileExtension(entry.path().extension()) && !settings.isIgnoredFile(entry.path()))
-						{
-							if (!codeGenUnit.isUpToDate(entry.path()) || forceRegenerateAll)
-							{
-								result.emplace(entry.path());
-							}
-							else
-							{
-								out_genResult.upToDateFiles.push_back(entry.path());
-							}
-						}
+						dependencies.insert(dependency.path);
 					}
-					else if (entry.is_directory() && settings.isIgnoredDirectory(entry.path()))
+				}
+			}
+		}
+
+		toHashFiles.insert(toHashFiles.cend(), dependencies.cbegin(), dependencies.cend());
+	}
+
+	//Files might already have been hashed for another unit
+	toHashFiles.erase(std::remove_if(toHashFiles.begin(), toHashFiles.end(), [&inout_contentHashes](fs::path const& file)
+									 {
+										 return inout_contentHashes.find(file) != inout_contentHashes.cend();
+									 }), toHashFiles.end());
+
+	hashFiles(toHashFiles, inout_contentHashes);
+
+	std::vector<fs::path> result;
+
+	for (fs::path const& file : candidates)
+	{
+		if (forceRegenerateAll ||
+			!manifest.isUpToDate(file, fingerprint, inout_contentHashes) ||
+			!codeGenUnit.isUpToDate(file))
+		{
+			result.emplace_back(file);
+		}
+	}
+
+	//Discovery order depends on the tasks scheduling, sort files to get a deterministic result
+	std::sort(result.begin(), result.end());
+
+	return result;
+}
+
+void CodeGenManager::watchProcessedPaths(FileWatcher& watcher, fs::path const& outputDirectory, std::unordered_set<fs::path, PathHash>& out_processedDirectories, std::unordered_set<fs::path, PathHash>& out_processedFiles) noexcept
+{
+	for (fs::path const& path : settings.getToProcessFiles())
+	{
+		fs::path file = FilesystemHelpers::sanitizePath(path);
+
+		if (!file.empty())
+		{
+			out_processedFiles.insert(file);
+			watcher.watchDirectory(file.parent_path(), false);
+		}
+	}
+
+	for (fs::path const& path : settings.getToProcessDirectories())
+	{
+		fs::path directory = FilesystemHelpers::sanitizePath(path);
+
+		if (!directory.empty() && directory != outputDirectory && fs::is_directory(directory))
+		{
+			out_processedDirectories.insert(directory);
+			watcher.watchDirectory(directory, true);
+		}
+	}
+}
+
+void CodeGenManager::watchDependencyDirectories(FileWatcher& watcher, CodeGenManifest const& manifest, fs::path const& outputDirectory, std::vector<fs::path> const& systemDirectories,
+												std::unordered_set<fs::path, PathHash>& inout_dependencyDirectories) noexcept
+{
+	std::unordered_set<fs::path, PathHash> dependencies;
+
+	manifest.getDependencies(dependencies);
+
+	for (fs::path const& dependency : dependencies)
+	{
+		//Directories are checked only once, whether they end up watched or not
+		if (!inout_dependencyDirectories.insert(dependency.parent_path()).second ||
+			FilesystemHelpers::isChildPath(dependency, outputDirectory) ||
+			std::any_of(systemDirectories.cbegin(), systemDirectories.cend(), [&dependency](fs::path const& systemDirectory)
+						{
+							return FilesystemHelpers::isChildPath(dependency, systemDirectory);
+						}))
+		{
+			continue;
+		}
+
+		watcher.watchDirectory(dependency.parent_path(), false);
+	}
+}
+
+void CodeGenManager::collectChangedFiles(std::vector<fs::path> const& changedFiles, std::unordered_set<fs::path, PathHash> const& processedDirectories, std::unordered_set<fs::path, PathHash> const& processedFiles,
+										 CodeGenManifest& manifest, std::unordered_set<fs::path, PathHash>& out_candidates) noexcept
+{
+	std::unordered_set<std::string> const&	supportedExtensions = settings.getSupportedExtensions();
+	std::unordered_set<fs::path, PathHash>	changedFileSet;
+
+	for (fs::path const& file : changedFiles)
+	{
+		//A file might have been reported multiple times
+		if (!changedFileSet.insert(file).second)
+		{
+			continue;
+		}
+
+		std::error_code error;
+
+		if (!fs::is_regular_file(file, error))
+		{
+			//Deleted files are not regenerated, but the files including them are
+			manifest.removeEntry(file);
+		}
+		else if (processedFiles.count(file) != 0u ||
+				 (processedDirectories.count(file.parent_path()) != 0u &&
+				  supportedExtensions.find(file.extension().string()) != supportedExtensions.cend() &&
+				  !settings.isIgnoredFile(file)))
+		{
+			out_candidates.insert(file);
+		}
+	}
+
+	std::unordered_set<fs::path, PathHash> dependentFiles;
+
+	manifest.getDependentFiles(changedFileSet, dependentFiles);
+
+	for (fs::path const& file : dependentFiles)
+	{
+		std::error_code error;
+
+		if (fs::is_regular_file(file, error))
+		{
+			out_candidates.insert(file);
+		}
+	}
+}
+
+void CodeGenManager::initProcessedFiles(std::vector<fs::path> const& toProcessFiles, CodeGenManifest const& manifest, std::unordered_map<fs::path, uint64, PathHash> const& contentHashes,
+										std::vector<ProcessedFile>& out_processedFiles) noexcept
+{
+	out_processedFiles.clear();
+	out_processedFiles.reserve(toProcessFiles.size());
+
+	for (fs::path const& file : toProcessFiles)
+	{
+		out_processedFiles.emplace_back().path = file;
+	}
+
+	collectProcessedDependencies(manifest, contentHashes, out_processedFiles);
+	predictProcessingDurations(manifest, out_processedFiles);
+}
+
+std::vector<std::vector<size_t>> CodeGenManager::makeShards(std::vector<std::vector<ProcessedFile>> const& processedFiles, uint32 shardCount) noexcept
+{
+	//All units process the same files
+	size_t fileCount = processedFiles.front().size();
+
+	//Group files connected by processed dependencies (union-find)
+	std::vector<size_t> groupRoots(fileCount);
+
+	std::iota(groupRoots.begin(), groupRoots.end(), 0u);
+
+	auto findRoot = [&groupRoots](size_t fileIndex)
+	{
+		while (groupRoots[fileIndex] != fileIndex)
+		{
+			groupRoots[fileIndex]	= groupRoots[groupRoots[fileIndex]];
+			fileIndex				= groupRoots[fileIndex];
+		}
+
+		return fileIndex;
+	};
+
+	for (std::vector<ProcessedFile> const& unitProcessedFiles : processedFiles)
+	{
+		for (size_t i = 0u; i < fileCount; i++)
+		{
+			for (size_t dependencyIndex : unitProcessedFiles[i].processedDependencies)
+			{
+				groupRoots[findRoot(i)] = findRoot(dependencyIndex);
+			}
+		}
+	}
+
+	std::vector<std::vector<size_t>>	groups;
+	std::vector<float>					groupCosts;
+	std::vector<size_t>					rootGroupIndices(fileCount, std::numeric_limits<size_t>::max());
+
+	for (size_t i = 0u; i < fileCount; i++)
+	{
+		size_t& groupIndex = rootGroupIndices[findRoot(i)];
+
+		if (groupIndex == std::numeric_limits<size_t>::max())
+		{
+			groupIndex = groups.size();
+
+			groups.emplace_back();
+			groupCosts.push_back(0.0f);
+		}
+
+		groups[groupIndex].push_back(i);
+
+		for (std::vector<ProcessedFile> const& unitProcessedFiles : processedFiles)
+		{
+			if (unitProcessedFiles[i].shouldGenerate)
+			{
+				groupCosts[groupIndex] += unitProcessedFiles[i].schedulingCost;
+			}
+		}
+	}
+
+	//Assign the most expensive groups first, each one to the least loaded shard (longest processing time first)
+	std::vector<size_t> groupOrder(groups.size());
+
+	std::iota(groupOrder.begin(), groupOrder.end(), 0u);
+	std::stable_sort(groupOrder.begin(), groupOrder.end(), [&groupCosts](size_t lhs, size_t rhs) { return groupCosts[lhs] > groupCosts[rhs]; });
+
+	std::vector<std::vector<size_t>>	shards(std::min<size_t>(shardCount, groups.size()));
+	std::vector<float>					shardCosts(shards.size(), 0.0f);
+
+	for (size_t groupIndex : groupOrder)
+	{
+		size_t shardIndex = static_cast<size_t>(std::min_element(shardCosts.cbegin(), shardCosts.cend()) - shardCosts.cbegin());
+
+		shards[shardIndex].insert(shards[shardIndex].cend(), groups[groupIndex].cbegin(), groups[groupIndex].cend());
+		shardCosts[shardIndex] += groupCosts[groupIndex];
+	}
+
+	return shards;
+}
+
+bool CodeGenManager::startShardWorker(std::function<void(int)> const& work, ShardWorker& out_worker) noexcept
+{
+#if _WIN32
+	(void)work;
+	(void)out_worker;
+
+	return false;
+#else
+	int pipeDescriptors[2];
+
+	if (pipe(pipeDescriptors) != 0)
+	{
+		return false;
+	}
+
+	pid_t processId = fork();
+
+	if (processId == -1)
+	{
+		close(pipeDescriptors[0]);
+		close(pipeDescriptors[1]);
+
+		return false;
+	}
+	else if (processId == 0)
+	{
+		//Worker process
+		close(pipeDescriptors[0]);
+
+		work(pipeDescriptors[1]);
+
+		close(pipeDescriptors[1]);
+
+		//Don't run the destructors of the objects inherited from the coordinator process, but don't lose the logs either
+		std::fflush(nullptr);
+		_exit(EXIT_SUCCESS);
+	}
+
+	close(pipeDescriptors[1]);
+
+	out_worker.processId		= processId;
+	out_worker.pipeDescriptor	= pipeDescriptors[0];
+	out_worker.lastReportTime	= std::chrono::high_resolution_clock::now();
+
+	return true;
+#endif
+}
+
+void CodeGenManager::writeShardPipe(int pipeDescriptor, std::string const& data) noexcept
+{
+#if _WIN32
+	(void)pipeDescriptor;
+	(void)data;
+#else
+	for (size_t writtenSize = 0u; writtenSize < data.size(); )
+	{
+		ssize_t result = write(pipeDescriptor, data.data() + writtenSize, data.size() - writtenSize);
+
+		if (result < 0 && errno != EINTR)
+		{
+			//The coordinator is gone, there is nobody to report to
+			return;
+		}
+
+		writtenSize += static_cast<size_t>(std::max<ssize_t>(result, 0));
+	}
+#endif
+}
+
+void CodeGenManager::writeShardReport(int pipeDescriptor, size_t unitIndex, ProcessedFile const& processedFile) noexcept
+{
+	//Report: "<unitIndex> <succeeded> <parsingCount> <parsingDuration> <sharedParsingDuration> <generationDuration> <includedFileCount> <path>" line followed by one line per included file.
+	//Durations are in microseconds. Paths are always the last element of their line since they might contain spaces.
+	std::string report = std::to_string(unitIndex) + " " +
+						 std::to_string(processedFile.succeeded ? 1 : 0) + " " +
+						 std::to_string(processedFile.parsingCount) + " " +
+						 std::to_string(static_cast<uint64>(processedFile.parsingDuration * 1000000.0f)) + " " +
+						 std::to_string(static_cast<uint64>(processedFile.sharedParsingDuration * 1000000.0f)) + " " +
+						 std::to_string(static_cast<uint64>(processedFile.generationDuration * 1000000.0f)) + " " +
+						 std::to_string(processedFile.includedFiles.size()) + " " +
+						 processedFile.path.string() + "\n";
+
+	for (fs::path const& includedFile : processedFile.includedFiles)
+	{
+		report += includedFile.string() + "\n";
+	}
+
+	writeShardPipe(pipeDescriptor, report);
+}
+
+void CodeGenManager::writeShardResult(int pipeDescriptor, CodeGenResult const& result) noexcept
+{
+	//Report: "result <completed> <predictedDuration> <measuredDuration> <predictionError> <parsedFileCount>" line followed by one line per parsed file.
+	//Durations are in microseconds.
+	std::string report = std::string("result ") +
+						 std::to_string(result.completed ? 1 : 0) + " " +
+						 std::to_string(static_cast<uint64>(result.predictedProcessingDuration * 1000000.0f)) + " " +
+						 std::to_string(static_cast<uint64>(result.measuredProcessingDuration * 1000000.0f)) + " " +
+						 std::to_string(static_cast<uint64>(result.processingDurationPredictionError * 1000000.0f)) + " " +
+						 std::to_string(result.parsedFiles.size()) + "\n";
+
+	for (fs::path const& parsedFile : result.parsedFiles)
+	{
+		report += parsedFile.string() + "\n";
+	}
+
+	writeShardPipe(pipeDescriptor, report);
+}
+
+bool CodeGenManager::readShardReport(ShardWorker& inout_worker, std::unordered_map<fs::path, size_t, PathHash> const& processedFileIndices,
+									 std::vector<std::vector<ProcessedFile>>& inout_processedFiles, std::vector<std::vector<bool>>& inout_isReported) noexcept
+{
+	std::string&	data		= inout_worker.receivedData;
+	size_t			headerEnd	= data.find('\n');
+
+	if (headerEnd == std::string::npos)
+	{
+		return false;
+	}
+
+	std::istringstream header(data.substr(0u, headerEnd));
+
+	//Generation result of the worker, see writeShardResult
+	if (data.compare(0u, 7u, "result ") == 0)
+	{
+		CodeGenResult	result;
+		std::string		tag;
+		uint32			completed			= 0u;
+		uint64			predictedDuration	= 0u;
+		uint64			measuredDuration	= 0u;
+		uint64			predictionError		= 0u;
+		size_t			parsedFileCount		= 0u;
+		size_t			lineStart			= headerEnd + 1u;
+
+		header >> tag >> completed >> predictedDuration >> measuredDuration >> predictionError >> parsedFileCount;
+
+		//Wait for all the parsed files of the report
+		for (size_t i = 0u; i < parsedFileCount; i++)
+		{
+			size_t lineEnd = data.find('\n', lineStart);
+
+			if (lineEnd == std::string::npos)
+			{
+				return false;
+			}
+
+			result.parsedFiles.emplace_back(data.substr(lineStart, lineEnd - lineStart));
+			lineStart = lineEnd + 1u;
+		}
+
+		data.erase(0u, lineStart);
+
+		result.completed							= (completed != 0u);
+		result.predictedProcessingDuration			= static_cast<float>(predictedDuration) * 0.000001f;
+		result.measuredProcessingDuration			= static_cast<float>(measuredDuration) * 0.000001f;
+		result.processingDurationPredictionError	= static_cast<float>(predictionError) * 0.000001f;
+		inout_worker.result							= std::move(result);
+
+		return true;
+	}
+
+	size_t				unitIndex				= 0u;
+	uint32				succeeded				= 0u;
+	uint32				parsingCount			= 0u;
+	uint64				parsingDuration			= 0u;
+	uint64				sharedParsingDuration	= 0u;
+	uint64				generationDuration		= 0u;
+	size_t				includedFileCount		= 0u;
+	std::string			path;
+
+	header >> unitIndex >> succeeded >> parsingCount >> parsingDuration >> sharedParsingDuration >> generationDuration >> includedFileCount;
+	header.get();
+	std::getline(header, path);
+
+	//Wait for all the included files of the report
+	std::vector<fs::path>	includedFiles;
+	size_t					lineStart = headerEnd + 1u;
+
+	for (size_t i = 0u; i < includedFileCount; i++)
+	{
+		size_t lineEnd = data.find('\n', lineStart);
+
+		if (lineEnd == std::string::npos)
+		{
+			return false;
+		}
+
+		includedFiles.emplace_back(data.substr(lineStart, lineEnd - lineStart));
+		lineStart = lineEnd + 1u;
+	}
+
+	data.erase(0u, lineStart);
+
+	auto it = processedFileIndices.find(path);
+
+	if (it != processedFileIndices.cend() && unitIndex < inout_processedFiles.size())
+	{
+		ProcessedFile& processedFile = inout_processedFiles[unitIndex][it->second];
+
+		processedFile.succeeded						= (succeeded != 0u);
+		processedFile.parsingCount					= static_cast<uint8>(parsingCount);
+		processedFile.parsingDuration				= static_cast<float>(parsingDuration) * 0.000001f;
+		processedFile.sharedParsingDuration			= static_cast<float>(sharedParsingDuration) * 0.000001f;
+		processedFile.generationDuration			= static_cast<float>(generationDuration) * 0.000001f;
+		processedFile.includedFiles					= std::move(includedFiles);
+		inout_isReported[unitIndex][it->second]		= true;
+	}
+
+	return true;
+}
+
+bool CodeGenManager::waitShardWorkers(std::vector<ShardWorker>& workers, std::chrono::milliseconds fileTimeout, std::unordered_map<fs::path, size_t, PathHash> const& processedFileIndices,
+									  std::vector<std::vector<ProcessedFile>>& inout_processedFiles, std::vector<std::vector<bool>>& inout_isReported) noexcept
+{
+#if _WIN32
+	(void)workers;
+	(void)fileTimeout;
+	(void)processedFileIndices;
+	(void)inout_processedFiles;
+	(void)inout_isReported;
+
+	return true;
+#else
+	constexpr int const pollingPeriod = 100;
+
+	std::vector<pollfd>	pollDescriptors;
+	size_t				runningWorkerCount = workers.size();
+
+	while (runningWorkerCount != 0u)
+	{
+		//Terminated workers have a -1 descriptor, which poll ignores
+		pollDescriptors.clear();
+
+		for (ShardWorker const& worker : workers)
+		{
+			pollDescriptors.push_back(pollfd{ worker.pipeDescriptor, POLLIN, 0 });
+		}
+
+		if (poll(pollDescriptors.data(), pollDescriptors.size(), pollingPeriod) == -1)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			if (logger != nullptr)
+			{
+				logger->log("Failed to poll the worker processes (errno " + std::to_string(errno) + "), they have been killed.", ILogger::ELogSeverity::Error);
+			}
+
+			//The reports of the workers can't be collected anymore, so don't let them generate files behind the manager's back
+			for (ShardWorker& worker : workers)
+			{
+				if (worker.pipeDescriptor != -1)
+				{
+					kill(worker.processId, SIGKILL);
+					close(worker.pipeDescriptor);
+					waitpid(worker.processId, nullptr, 0);
+
+					worker.pipeDescriptor = -1;
+				}
+			}
+
+			return false;
+		}
+
+		auto now = std::chrono::high_resolution_clock::now();
+
+		for (size_t i = 0u; i < workers.size(); i++)
+		{
+			ShardWorker&	worker			= workers[i];
+			bool			hasTerminated	= false;
+			bool			hasBeenKilled	= false;
+
+			if (worker.pipeDescriptor == -1)
+			{
+				continue;
+			}
+
+			if (pollDescriptors[i].revents != 0)
+			{
+				char	buffer[4096];
+				ssize_t	readSize = read(worker.pipeDescriptor, buffer, sizeof(buffer));
+
+				if (readSize > 0)
+				{
+					worker.receivedData.append(buffer, static_cast<size_t>(readSize));
+
+					while (readShardReport(worker, processedFileIndices, inout_processedFiles, inout_isReported))
 					{
-						//Don't iterate on ignored directory content
-						directoryIt.disable_recursion_pending();
+						worker.lastReportTime = now;
 					}
 				}
+				else if (readSize == 0 || errno != EINTR)
+				{
+					//The worker closed the pipe: it either completed or crashed
+					hasTerminated = true;
+				}
+			}
+			else if (now - worker.lastReportTime > fileTimeout)
+			{
+				if (logger != nullptr)
+				{
+					logger->log("Worker process " + std::to_string(worker.processId) + " didn't report any processed file for " + std::to_string(fileTimeout.count()) + "ms and has been killed.", ILogger::ELogSeverity::Warning);
+				}
+
+				kill(worker.processId, SIGKILL);
+				hasTerminated = true;
+				hasBeenKilled = true;
+			}
+
+			if (hasTerminated)
+			{
+				int status = 0;
+
+				close(worker.pipeDescriptor);
+				waitpid(worker.processId, &status, 0);
+
+				if (!WIFEXITED(status) && !hasBeenKilled && logger != nullptr)
+				{
+					logger->log("Worker process " + std::to_string(worker.processId) + " terminated abnormally, its unreported files will be retried one by one.", ILogger::ELogSeverity::Warning);
+				}
+
+				worker.pipeDescriptor = -1;
+				runningWorkerCount--;
 			}
 		}
-		else if (logger != nullptr)
+	}
+
+	return true;
+#endif
+}
+
+void CodeGenManager::collectProcessedDependencies(CodeGenManifest const& manifest, std::unordered_map<fs::path, uint64, PathHash> const& contentHashes, std::vector<ProcessedFile>& inout_processedFiles) noexcept
+{
+	std::unordered_map<fs::path, size_t, PathHash> processedFileIndices;
+
+	for (size_t i = 0u; i < inout_processedFiles.size(); i++)
+	{
+		processedFileIndices.emplace(inout_processedFiles[i].path, i);
+	}
+
+	for (ProcessedFile& processedFile : inout_processedFiles)
+	{
+		CodeGenManifest::Entry const*	entry		= manifest.getEntry(processedFile.path);
+		auto							contentHash	= contentHashes.find(processedFile.path);
+
+		//The includes of a modified file might have changed since the manifest was saved
+		processedFile.areDependenciesKnown = entry != nullptr && contentHash != contentHashes.cend() && contentHash->second == entry->contentHash;
+
+		if (processedFile.areDependenciesKnown)
 		{
-			//Add FileGenerationFile invalid path
-			logger->log("Directory " + pathToIncludedDir.string() + " is not a directory or doesn't exist. Skip.", ILogger::ELogSeverity::Warning);
+			for (CodeGenManifest::Dependency const& dependency : entry->dependencies)
+			{
+				auto it = processedFileIndices.find(dependency.path);
+
+				if (it != processedFileIndices.cend())
+				{
+					processedFile.processedDependencies.push_back(it->second);
+				}
+			}
 		}
 	}
+}
 
-	return result;
+void CodeGenManager::predictProcessingDurations(CodeGenManifest const& manifest, std::vector<ProcessedFile>& inout_processedFiles) noexcept
+{
+	//Sizes are only retrieved for files without history
+	std::vector<uint64>	fileSizes(inout_processedFiles.size(), 0u);
+	double				historyDuration	= 0.0;
+	double				historySize		= 0.0;
+
+	for (size_t i = 0u; i < inout_processedFiles.size(); i++)
+	{
+		ProcessedFile&	processedFile = inout_processedFiles[i];
+		std::error_code	error;
+		uint64			fileSize = fs::file_size(processedFile.path, error);
+
+		if (error)
+		{
+			fileSize = 0u;
+		}
+
+		CodeGenManifest::Entry const* entry = manifest.getEntry(processedFile.path);
+
+		if (entry != nullptr && (entry->parsingDuration != 0u || entry->generationDuration != 0u))
+		{
+			processedFile.predictedDuration			= (static_cast<float>(entry->parsingDuration) + static_cast<float>(entry->generationDuration)) * 0.000001f;
+			processedFile.predictedParsingDuration	= static_cast<float>(entry->parsingDuration) * 0.000001f;
+
+			historyDuration	+= *processedFile.predictedDuration;
+			historySize		+= static_cast<double>(fileSize);
+		}
+		else
+		{
+			fileSizes[i] = fileSize;
+		}
+	}
+
+	//Average processing duration of a byte, used to predict the duration of files without history
+	opt::optional<double> durationPerByte;
+
+	if (historySize > 0.0)
+	{
+		durationPerByte = historyDuration / historySize;
+	}
+
+	for (size_t i = 0u; i < inout_processedFiles.size(); i++)
+	{
+		ProcessedFile& processedFile = inout_processedFiles[i];
+
+		if (!processedFile.predictedDuration.has_value() && durationPerByte.has_value())
+		{
+			processedFile.predictedDuration = static_cast<float>(static_cast<double>(fileSizes[i]) * *durationPerByte);
+		}
+
+		//If there is no history at all, fallback to the file size to order files
+		processedFile.schedulingCost = processedFile.predictedDuration.value_or(static_cast<float>(fileSizes[i]));
+	}
+}
+
+void CodeGenManager::shareParsingDurations(std::vector<std::vector<ProcessedFile>>& inout_processedFiles) noexcept
+{
+	for (size_t i = 0u; i < inout_processedFiles.front().size(); i++)
+	{
+		ProcessedFile* accountingFile = nullptr;
+
+		for (std::vector<ProcessedFile>& unitProcessedFiles : inout_processedFiles)
+		{
+			ProcessedFile& processedFile = unitProcessedFiles[i];
+
+			if (!processedFile.shouldGenerate)
+			{
+				continue;
+			}
+			else if (accountingFile == nullptr)
+			{
+				accountingFile = &processedFile;
+				continue;
+			}
+
+			processedFile.accountsSharedParsing = false;
+
+			//The parsing history of a unit reparsing the file between iterations is longer, the shortest one is the closest to a single parsing
+			if (processedFile.predictedParsingDuration.has_value() && accountingFile->predictedParsingDuration.has_value())
+			{
+				float sharedParsingDuration = std::min(*processedFile.predictedParsingDuration, *accountingFile->predictedParsingDuration);
+
+				processedFile.predictedDuration	= *processedFile.predictedDuration - sharedParsingDuration;
+				processedFile.schedulingCost	-= sharedParsingDuration;
+			}
+		}
+	}
+}
+
+void CodeGenManager::reportProcessingDurations(std::vector<ProcessedFile> const& processedFiles, CodeGenResult& out_genResult) noexcept
+{
+	for (ProcessedFile const& processedFile : processedFiles)
+	{
+		reportProcessingDuration(processedFile, out_genResult);
+	}
+}
+
+void CodeGenManager::reportProcessingDuration(ProcessedFile const& processedFile, CodeGenResult& out_genResult) noexcept
+{
+	if (processedFile.shouldGenerate && processedFile.predictedDuration.has_value())
+	{
+		float measuredDuration = processedFile.parsingDuration + processedFile.generationDuration;
+
+		if (!processedFile.accountsSharedParsing)
+		{
+			measuredDuration -= processedFile.sharedParsingDuration;
+		}
+
+		out_genResult.predictedProcessingDuration		+= *processedFile.predictedDuration;
+		out_genResult.measuredProcessingDuration		+= measuredDuration;
+		out_genResult.processingDurationPredictionError	+= std::abs(*processedFile.predictedDuration - measuredDuration);
+	}
+}
+
+void CodeGenManager::hashFiles(std::vector<fs::path> const& files, std::unordered_map<fs::path, uint64, PathHash>& out_contentHashes) noexcept
+{
+	//Each task writes to its own range of the vector, so no synchronization is required
+	constexpr size_t const filesPerTask = 32u;
+
+	std::vector<opt::optional<uint64>>	contentHashes(files.size());
+	TaskGroup							hashingGroup(_threadPool);
+
+	hashingGroup.parallelFor(0u, files.size(), filesPerTask, [&files, &contentHashes](size_t i)
+							 {
+								 contentHashes[i] = HashHelpers::hashFileContent(files[i]);
+							 });
+
+	//The current thread hashes files too instead of waiting idle
+	hashingGroup.wait();
+
+	for (size_t i = 0u; i < files.size(); i++)
+	{
+		if (contentHashes[i].has_value())
+		{
+			out_contentHashes.insert_or_assign(files[i], *contentHashes[i]);
+		}
+	}
+}
+
+void CodeGenManager::updateManifest(CodeGenManifest& manifest, fs::path const& manifestFile, uint64 fingerprint, fs::path const& outputDirectory,
+									std::vector<ProcessedFile> const& processedFiles, std::unordered_map<fs::path, uint64, PathHash>& inout_contentHashes) noexcept
+{
+	auto toMicroseconds = [](float seconds)
+	{
+		return static_cast<uint32>(std::min(static_cast<double>(seconds) * 1000000.0, static_cast<double>(std::numeric_limits<uint32>::max())));
+	};
+
+	//Generated files are outputs of the generation, not inputs
+	//Use a lexical check since this is called for each include of each file
+	auto isDependency = [&outputDirectory](fs::path const& file, fs::path const& includedFile)
+	{
+		fs::path relativePath = includedFile.lexically_relative(outputDirectory);
+
+		return includedFile != file && (relativePath.empty() || *relativePath.begin() == "..");
+	};
+
+	//Hash all dependencies discovered during this generation
+	std::unordered_set<fs::path, PathHash> unknownDependencies;
+
+	for (ProcessedFile const& processedFile : processedFiles)
+	{
+		if (processedFile.shouldGenerate && processedFile.succeeded)
+		{
+			for (fs::path const& includedFile : processedFile.includedFiles)
+			{
+				if (isDependency(processedFile.path, includedFile) && inout_contentHashes.find(includedFile) == inout_contentHashes.cend())
+				{
+					unknownDependencies.insert(includedFile);
+				}
+			}
+		}
+	}
+
+	hashFiles(std::vector<fs::path>(unknownDependencies.cbegin(), unknownDependencies.cend()), inout_contentHashes);
+
+	for (ProcessedFile const& processedFile : processedFiles)
+	{
+		//Files up to date for this unit keep their entry
+		if (!processedFile.shouldGenerate)
+		{
+			continue;
+		}
+
+		auto fileHashIt = inout_contentHashes.find(processedFile.path);
+
+		//Failed files must be regenerated next time, whatever their content
+		//Files which could not be hashed are regenerated but never recorded in the manifest
+		if (!processedFile.succeeded || fileHashIt == inout_contentHashes.cend())
+		{
+			manifest.removeEntry(processedFile.path);
+			continue;
+		}
+
+		CodeGenManifest::Entry	entry;
+		bool					allDependenciesHashed = true;
+
+		entry.contentHash			= fileHashIt->second;
+		entry.fingerprint			= fingerprint;
+		entry.parsingDuration		= toMicroseconds(processedFile.parsingDuration);
+		entry.generationDuration	= toMicroseconds(processedFile.generationDuration);
+
+		for (fs::path const& includedFile : processedFile.includedFiles)
+		{
+			if (isDependency(processedFile.path, includedFile))
+			{
+				auto dependencyHashIt = inout_contentHashes.find(includedFile);
+
+				if (dependencyHashIt == inout_contentHashes.cend())
+				{
+					allDependenciesHashed = false;
+					break;
+				}
+
+				entry.dependencies.push_back(CodeGenManifest::Dependency{ includedFile, dependencyHashIt->second });
+			}
+		}
+
+		if (allDependenciesHashed)
+		{
+			manifest.updateEntry(processedFile.path, entry);
+		}
+		else
+		{
+			manifest.removeEntry(processedFile.path);
+		}
+	}
+
+	//Sources deleted since their last generation are never processed again, so nothing else would remove their entry
+	manifest.removeDeletedFiles();
+
+	if (!manifest.saveToFile(manifestFile) && logger != nullptr)
+	{
+		logger->log("Failed to save the generation manifest to " + manifestFile.string() + ". All files will be regenerated next time.", ILogger::ELogSeverity::Warning);
+	}
 }
 
 uint32 CodeGenManager::getThreadCount(uint32 initialThreadCount) const noexcept
@@ -167,6 +167,21 @@ bool CodeGenManagerSettings::isIgnoredFile(fs::path const& file) noexcept
 	return _ignoredFiles.find(fs::exists(file) ? FilesystemHelpers::sanitizePath(file) : file) != _ignoredFiles.end();
 }
 
+void CodeGenManagerSettings::sanitizeIgnoredPaths() noexcept
+{
+	if (_ignoredFilesDirtyFlag)
+	{
+		sanitizePaths(_ignoredFiles);
+		_ignoredFilesDirtyFlag = false;
+	}
+
+	if (_ignoredDirectoriesDirtyFlag)
+	{
+		sanitizePaths(_ignoredDirectories);
+		_ignoredDirectoriesDirtyFlag = false;
+	}
+}
+
 bool CodeGenManagerSettings::isIgnoredDirectory(fs::path const& directory) noexcept
 {
 	if (_ignoredDirectoriesDirtyFlag)
@@ -0,0 +1,260 @@
+#include "Kodgen/CodeGen/CodeGenManifest.h"
+
+#include <fstream>
+#include <sstream>	//std::istringstream
+
+using namespace kodgen;
+
+bool CodeGenManifest::loadFromFile(fs::path const& manifestFile) noexcept
+{
+	_entries.clear();
+
+	std::ifstream stream(manifestFile);
+
+	if (!stream.is_open())
+	{
+		return false;
+	}
+
+	std::string	header;
+	uint32		version = 0u;
+
+	stream >> header >> version;
+
+	if (header != _fileHeader || version != _formatVersion)
+	{
+		return false;
+	}
+
+	std::vector<fs::path>	dependencyPaths;
+	std::string				line;
+	std::string				path;
+	char					lineType;
+
+	while (std::getline(stream, line))
+	{
+		if (line.empty())
+		{
+			continue;
+		}
+
+		std::istringstream lineStream(line);
+
+		lineStream >> lineType;
+
+		//Paths are written last since they might contain spaces
+		if (lineType == 'D')
+		{
+			lineStream.get();
+
+			if (!std::getline(lineStream, path) || path.empty())
+			{
+				//Corrupted manifest, discard everything
+				_entries.clear();
+
+				return false;
+			}
+
+			dependencyPaths.emplace_back(path);
+		}
+		else if (lineType == 'F')
+		{
+			Entry	entry;
+			size_t	dependencyCount = 0u;
+
+			lineStream >> std::hex >> entry.contentHash >> entry.fingerprint >> entry.parsingDuration >> entry.generationDuration >> dependencyCount;
+
+			for (size_t i = 0u; i < dependencyCount && !lineStream.fail(); i++)
+			{
+				size_t		dependencyIndex = 0u;
+				Dependency	dependency;
+
+				lineStream >> dependencyIndex >> dependency.contentHash;
+
+				if (dependencyIndex >= dependencyPaths.size())
+				{
+					lineStream.setstate(std::ios::failbit);
+					break;
+				}
+
+				dependency.path = dependencyPaths[dependencyIndex];
+				entry.dependencies.emplace_back(std::move(dependency));
+			}
+
+			lineStream.get();
+
+			if (lineStream.fail() || !std::getline(lineStream, path) || path.empty())
+			{
+				//Corrupted manifest, discard everything
+				_entries.clear();
+
+				return false;
+			}
+
+			_entries.insert_or_assign(fs::path(path), std::move(entry));
+		}
+		else
+		{
+			_entries.clear();
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool CodeGenManifest::saveToFile(fs::path const& manifestFile) const noexcept
+{
+	fs::path temporaryFile = manifestFile;
+	temporaryFile += ".tmp";
+
+	{
+		std::ofstream stream(temporaryFile, std::ios::out | std::ios::trunc);
+
+		if (!stream.is_open())
+		{
+			return false;
+		}
+
+		stream << _fileHeader << " " << _formatVersion << "\n" << std::hex;
+
+		//Most dependencies are shared by many files, so write each dependency path once and reference it by index
+		std::unordered_map<fs::path, size_t, PathHash> dependencyIndices;
+
+		for (auto const& [path, entry] : _entries)
+		{
+			for (Dependency const& dependency : entry.dependencies)
+			{
+				if (dependencyIndices.try_emplace(dependency.path, dependencyIndices.size()).second)
+				{
+					stream << "D " << dependency.path.string() << "\n";
+				}
+			}
+		}
+
+		for (auto const& [path, entry] : _entries)
+		{
+			stream << "F " << entry.contentHash << " " << entry.fingerprint << " " << entry.parsingDuration << " " << entry.generationDuration << " " << entry.dependencies.size();
+
+			for (Dependency const& dependency : entry.dependencies)
+			{
+				stream << " " << dependencyIndices[dependency.path] << " " << dependency.contentHash;
+			}
+
+			stream << " " << path.string() << "\n";
+		}
+
+		if (!stream.good())
+		{
+			return false;
+		}
+	}
+
+	std::error_code error;
+	fs::rename(temporaryFile, manifestFile, error);
+
+	return !error;
+}
+
+bool CodeGenManifest::isUpToDate(fs::path const& file, uint64 fingerprint, std::unordered_map<fs::path, uint64, PathHash> const& contentHashes) const noexcept
+{
+	Entry const* entry = getEntry(file);
+
+	if (entry == nullptr || entry->fingerprint != fingerprint)
+	{
+		return false;
+	}
+
+	auto isUnchanged = [&contentHashes](fs::path const& path, uint64 recordedHash)
+	{
+		auto it = contentHashes.find(path);
+
+		return it != contentHashes.cend() && it->second == recordedHash;
+	};
+
+	if (!isUnchanged(file, entry->contentHash))
+	{
+		return false;
+	}
+
+	for (Dependency const& dependency : entry->dependencies)
+	{
+		if (!isUnchanged(dependency.path, dependency.contentHash))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+CodeGenManifest::Entry const* CodeGenManifest::getEntry(fs::path const& file) const noexcept
+{
+	auto it = _entries.find(file);
+
+	return (it != _entries.cend()) ? &it->second : nullptr;
+}
+
+void CodeGenManifest::getDependentFiles(std::unordered_set<fs::path, PathHash> const& files, std::unordered_set<fs::path, PathHash>& out_dependentFiles) const noexcept
+{
+	for (auto const& [path, entry] : _entries)
+	{
+		for (Dependency const& dependency : entry.dependencies)
+		{
+			if (files.count(dependency.path) != 0u)
+			{
+				out_dependentFiles.insert(path);
+				break;
+			}
+		}
+	}
+}
+
+void CodeGenManifest::getDependencies(std::unordered_set<fs::path, PathHash>& out_dependencies) const noexcept
+{
+	for (auto const& [path, entry] : _entries)
+	{
+		for (Dependency const& dependency : entry.dependencies)
+		{
+			out_dependencies.insert(dependency.path);
+		}
+	}
+}
+
+void CodeGenManifest::updateEntry(fs::path const& file, Entry const& entry) noexcept
+{
+	_entries.insert_or_assign(file, entry);
+}
+
+bool CodeGenManifest::removeEntry(fs::path const& file) noexcept
+{
+	return _entries.erase(file) != 0u;
+}
+
+size_t CodeGenManifest::removeDeletedFiles() noexcept
+{
+	size_t			removedEntryCount = 0u;
+	std::error_code	errorCode;
+
+	for (auto it = _entries.begin(); it != _entries.end();)
+	{
+		//Keep the entry if the existence of the file can't be checked
+		if (!fs::exists(it->first, errorCode) && !errorCode)
+		{
+			it = _entries.erase(it);
+			removedEntryCount++;
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	return removedEntryCount;
+}
+
+void CodeGenManifest::clear() noexcept
+{
+	_entries.clear();
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "Kodgen/CodeGen/PropertyCodeGen.h"
 #include "Kodgen/CodeGen/CodeGenEnv.h"
+#include "Kodgen/Misc/HashHelpers.h"
 
 using namespace kodgen;
 
@@ -18,6 +19,35 @@ int32 CodeGenModule::getGenerationOrder() const noexcept
 	return (*it)->getIterationCount();
 }
 
+uint64 CodeGenModule::computeFingerprint() const noexcept
+{
+	uint64 result = ICodeGenerator::computeFingerprint();
+
+	for (PropertyCodeGen const* propertyCodeGen : _propertyCodeGenerators)
+	{
+		result = HashHelpers::combine(result, propertyCodeGen->computeFingerprint());
+	}
+
+	return result;
+}
+
+bool CodeGenModule::shouldReparseBetweenIterations() const noexcept
+{
+	return std::any_of(_propertyCodeGenerators.cbegin(), _propertyCodeGenerators.cend(),
+					   [](PropertyCodeGen const* propertyCodeGen)
+					   {
+						   return propertyCodeGen->shouldReparseBetweenIterations();
+					   });
+}
+
+void CodeGenModule::resetGenerationState() noexcept
+{
+	for (PropertyCodeGen* propertyCodeGen : _propertyCodeGenerators)
+	{
+		propertyCodeGen->resetGenerationState();
+	}
+}
+
 ETraversalBehaviour CodeGenModule::generateCodeForEntity(EntityInfo const& entity, CodeGenEnv& env, std::string& inout_result, void const* /* data */) noexcept
 {
 	return generateCodeForEntity(entity, env, inout_result);
@@ -0,0 +1,186 @@
+#include "Kodgen/CodeGen/CodeGenProtocol.h"
+
+#include <cstdlib>	//std::strtof
+
+using namespace kodgen;
+
+bool CodeGenProtocol::receiveHeader(LocalSocket& socket, char const* header) noexcept
+{
+	std::string line;
+
+	return socket.receiveLine(line) && line == std::string(header) + " " + std::to_string(_version);
+}
+
+bool CodeGenProtocol::receiveField(LocalSocket& socket, std::string& out_key, std::string& out_value, bool& out_isMessageEnd) noexcept
+{
+	std::string line;
+
+	if (!socket.receiveLine(line))
+	{
+		return false;
+	}
+
+	out_isMessageEnd = (line == _messageEnd);
+
+	size_t separatorPosition = line.find(' ');
+
+	out_key		= line.substr(0u, separatorPosition);
+	out_value	= (separatorPosition != std::string::npos) ? line.substr(separatorPosition + 1u) : std::string();
+
+	return true;
+}
+
+bool CodeGenProtocol::sendRequest(LocalSocket& socket, CodeGenRequest const& request) noexcept
+{
+	std::string message = std::string(_requestHeader) + " " + std::to_string(_version) + "\n";
+
+	//The server doesn't run in the working directory of the client, so relative paths are resolved here
+	auto appendPaths = [&message](char const* key, std::vector<fs::path> const& paths)
+	{
+		for (fs::path const& path : paths)
+		{
+			std::error_code error;
+			fs::path		absolutePath = fs::absolute(path, error);
+
+			message += std::string(key) + " " + (error ? path : absolutePath).string() + "\n";
+		}
+	};
+
+	appendPaths("file", request.toProcessFiles);
+	appendPaths("directory", request.toProcessDirectories);
+	appendPaths("ignoredFile", request.ignoredFiles);
+	appendPaths("ignoredDirectory", request.ignoredDirectories);
+
+	if (request.forceRegenerateAll)
+	{
+		message += "force\n";
+	}
+
+	message += std::string(_messageEnd) + "\n";
+
+	return socket.send(message);
+}
+
+bool CodeGenProtocol::receiveRequest(LocalSocket& socket, CodeGenRequest& out_request) noexcept
+{
+	if (!receiveHeader(socket, _requestHeader))
+	{
+		return false;
+	}
+
+	std::string	key;
+	std::string	value;
+	bool		isMessageEnd = false;
+
+	while (receiveField(socket, key, value, isMessageEnd) && !isMessageEnd)
+	{
+		//Relative paths would be resolved against the working directory of the server instead of the one of the client
+		if (key != "force" && !fs::path(value).is_absolute())
+		{
+			return false;
+		}
+
+		if (key == "file")
+		{
+			out_request.toProcessFiles.emplace_back(value);
+		}
+		else if (key == "directory")
+		{
+			out_request.toProcessDirectories.emplace_back(value);
+		}
+		else if (key == "ignoredFile")
+		{
+			out_request.ignoredFiles.emplace_back(value);
+		}
+		else if (key == "ignoredDirectory")
+		{
+			out_request.ignoredDirectories.emplace_back(value);
+		}
+		else if (key == "force")
+		{
+			out_request.forceRegenerateAll = true;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	//The connection might have been closed before the end of the message
+	return isMessageEnd;
+}
+
+bool CodeGenProtocol::sendResult(LocalSocket& socket, CodeGenResult const& genResult) noexcept
+{
+	std::string message = std::string(_resultHeader) + " " + std::to_string(_version) + "\n";
+
+	message += "completed " + std::to_string(genResult.completed ? 1 : 0) + "\n";
+	message += "duration " + std::to_string(genResult.duration) + "\n";
+	message += "predictedProcessingDuration " + std::to_string(genResult.predictedProcessingDuration) + "\n";
+	message += "measuredProcessingDuration " + std::to_string(genResult.measuredProcessingDuration) + "\n";
+	message += "processingDurationPredictionError " + std::to_string(genResult.processingDurationPredictionError) + "\n";
+
+	for (fs::path const& path : genResult.parsedFiles)
+	{
+		message += "parsedFile " + path.string() + "\n";
+	}
+
+	for (fs::path const& path : genResult.upToDateFiles)
+	{
+		message += "upToDateFile " + path.string() + "\n";
+	}
+
+	message += std::string(_messageEnd) + "\n";
+
+	return socket.send(message);
+}
+
+bool CodeGenProtocol::receiveResult(LocalSocket& socket, CodeGenResult& out_genResult) noexcept
+{
+	if (!receiveHeader(socket, _resultHeader))
+	{
+		return false;
+	}
+
+	std::string	key;
+	std::string	value;
+	bool		isMessageEnd = false;
+
+	while (receiveField(socket, key, value, isMessageEnd) && !isMessageEnd)
+	{
+		if (key == "completed")
+		{
+			out_genResult.completed = (value == "1");
+		}
+		else if (key == "duration")
+		{
+			out_genResult.duration = std::strtof(value.c_str(), nullptr);
+		}
+		else if (key == "predictedProcessingDuration")
+		{
+			out_genResult.predictedProcessingDuration = std::strtof(value.c_str(), nullptr);
+		}
+		else if (key == "measuredProcessingDuration")
+		{
+			out_genResult.measuredProcessingDuration = std::strtof(value.c_str(), nullptr);
+		}
+		else if (key == "processingDurationPredictionError")
+		{
+			out_genResult.processingDurationPredictionError = std::strtof(value.c_str(), nullptr);
+		}
+		else if (key == "parsedFile")
+		{
+			out_genResult.parsedFiles.emplace_back(value);
+		}
+		else if (key == "upToDateFile")
+		{
+			out_genResult.upToDateFiles.emplace_back(value);
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return isMessageEnd;
+}
\ No newline at end of file
@@ -7,5 +7,9 @@ void CodeGenResult::mergeResult(CodeGenResult&& otherResult) noexcept
 	parsedFiles.insert(parsedFiles.cend(), std::make_move_iterator(otherResult.parsedFiles.cbegin()), std::make_move_iterator(otherResult.parsedFiles.cend()));
 	upToDateFiles.insert(upToDateFiles.cend(), std::make_move_iterator(otherResult.upToDateFiles.cbegin()), std::make_move_iterator(otherResult.upToDateFiles.cend()));
 
+	predictedProcessingDuration			+= otherResult.predictedProcessingDuration;
+	measuredProcessingDuration			+= otherResult.measuredProcessingDuration;
+	processingDurationPredictionError	+= otherResult.processingDurationPredictionError;
+
 	completed &= otherResult.completed;
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "Kodgen/CodeGen/CodeGenServer.h"
+
+using namespace kodgen;
+
+void CodeGenServer::applyRequest(CodeGenRequest const& request, CodeGenManagerSettings& inout_settings) noexcept
+{
+	if (!request.toProcessFiles.empty() || !request.toProcessDirectories.empty())
+	{
+		inout_settings.clearToProcessFiles();
+		inout_settings.clearToProcessDirectories();
+
+		for (fs::path const& file : request.toProcessFiles)
+		{
+			inout_settings.addToProcessFile(file);
+		}
+
+		for (fs::path const& directory : request.toProcessDirectories)
+		{
+			inout_settings.addToProcessDirectory(directory);
+		}
+	}
+
+	for (fs::path const& file : request.ignoredFiles)
+	{
+		inout_settings.addIgnoredFile(file);
+	}
+
+	for (fs::path const& directory : request.ignoredDirectories)
+	{
+		inout_settings.addIgnoredDirectory(directory);
+	}
+}
+
+bool CodeGenServer::start(fs::path const& socketPath) noexcept
+{
+	if (!_socket.listen(socketPath))
+	{
+		if (logger != nullptr)
+		{
+			logger->log("Could not listen to the local socket " + socketPath.string() + ".", ILogger::ELogSeverity::Error);
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+void CodeGenServer::stop() noexcept
+{
+	_isStopRequested.store(true);
+}
\ No newline at end of file
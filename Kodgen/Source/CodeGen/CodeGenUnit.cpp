@@ -4,6 +4,7 @@
 
 #include "Kodgen/CodeGen/CodeGenHelpers.h"
 #include "Kodgen/CodeGen/PropertyCodeGen.h"
+#include "Kodgen/Misc/HashHelpers.h"
 
 #define HANDLE_NESTED_ENTITY_ITERATION_RESULT(result)																\
 	if (result == ETraversalBehaviour::Break)																		\
@@ -493,6 +494,66 @@ uint8 CodeGenUnit::getIterationCount() const noexcept
 	}
 }
 
+bool CodeGenUnit::shouldReparseBetweenIterations() const noexcept
+{
+	return std::any_of(_generationModules.cbegin(), _generationModules.cend(),
+					   [](CodeGenModule const* codeGenModule)
+					   {
+						   return codeGenModule->shouldReparseBetweenIterations();
+					   });
+}
+
+uint64 CodeGenUnit::computeFingerprint() const noexcept
+{
+	uint64 result = (settings != nullptr) ? settings->computeFingerprint() : HashHelpers::initialHash;
+
+	for (CodeGenModule const* codeGenModule : _generationModules)
+	{
+		result = HashHelpers::combine(result, codeGenModule->computeFingerprint());
+	}
+
+	return result;
+}
+
+void CodeGenUnit::resetGenerationState() noexcept
+{
+	for (CodeGenModule* codeGenModule : _generationModules)
+	{
+		codeGenModule->resetGenerationState();
+	}
+}
+
+bool CodeGenUnit::supportsReuse() const noexcept
+{
+	return false;
+}
+
+bool CodeGenUnit::isReusable() const noexcept
+{
+	if (!supportsReuse())
+	{
+		return false;
+	}
+
+	for (CodeGenModule const* codeGenModule : _generationModules)
+	{
+		if (!codeGenModule->supportsReuse())
+		{
+			return false;
+		}
+
+		for (PropertyCodeGen const* propertyCodeGen : codeGenModule->getPropertyCodeGenerators())
+		{
+			if (!propertyCodeGen->supportsReuse())
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 std::vector<CodeGenModule*>	const& CodeGenUnit::getRegisteredCodeGenModules() const noexcept
 {
 	return _generationModules;
@@ -2,6 +2,7 @@
 
 #include "Kodgen/Misc/TomlUtility.h"
 #include "Kodgen/Misc/ILogger.h"
+#include "Kodgen/Misc/HashHelpers.h"
 
 using namespace kodgen;
 
@@ -83,4 +84,9 @@ bool CodeGenUnitSettings::setOutputDirectory(fs::path outputDirectory) noexcept
 	}
 
 	return false;
+}
+
+uint64 CodeGenUnitSettings::computeFingerprint() const noexcept
+{
+	return HashHelpers::hash(_outputDirectory.string());
 }
\ No newline at end of file
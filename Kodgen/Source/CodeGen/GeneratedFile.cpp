@@ -1,27 +1,44 @@
 #include "Kodgen/CodeGen/GeneratedFile.h"
 
+#include <fstream>
+#include <iterator>	//std::istreambuf_iterator
+
 using namespace kodgen;
 
 GeneratedFile::GeneratedFile(fs::path&& generatedFilePath, fs::path const& sourceFilePath) noexcept:
 	_path{std::forward<fs::path>(generatedFilePath)},
-	_sourceFilePath{sourceFilePath},
-	_streamToFile(_path.string(), std::ios::out | std::ios::trunc)
+	_sourceFilePath{sourceFilePath}
 {
 }
 
 GeneratedFile::~GeneratedFile() noexcept
 {
-	_streamToFile.close();
+	//Rewriting an unchanged file would invalidate everything depending on its last write time,
+	//like the translation units including it or the user build
+	{
+		std::ifstream existingFile(_path);
+
+		if (existingFile.is_open() && std::string(std::istreambuf_iterator<char>(existingFile), std::istreambuf_iterator<char>()) == _content)
+		{
+			return;
+		}
+	}
+
+	std::ofstream streamToFile(_path, std::ios::out | std::ios::trunc);
+
+	streamToFile << _content;
 }
 
 void GeneratedFile::writeLine(std::string const& line) noexcept
 {
-	_streamToFile << line << "\n";
+	_content += line;
+	_content += "\n";
 }
 
 void GeneratedFile::writeLine(std::string&& line) noexcept
 {
-	_streamToFile << std::forward<std::string>(line) << "\n";
+	_content += std::forward<std::string>(line);
+	_content += "\n";
 }
 
 void GeneratedFile::writeLines(std::string const& line) noexcept
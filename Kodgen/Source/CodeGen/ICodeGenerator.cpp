@@ -1,5 +1,12 @@
 #include "Kodgen/CodeGen/ICodeGenerator.h"
 
+#include "Kodgen/Config.h"
+#include "Kodgen/Misc/HashHelpers.h"
+
+#ifdef RTTI_ENABLED
+#include <typeinfo>
+#endif
+
 using namespace kodgen;
 
 int32 ICodeGenerator::getGenerationOrder() const noexcept
@@ -10,4 +17,31 @@ int32 ICodeGenerator::getGenerationOrder() const noexcept
 uint8 ICodeGenerator::getIterationCount() const noexcept
 {
 	return 1u;
+}
+
+bool ICodeGenerator::shouldReparseBetweenIterations() const noexcept
+{
+	return false;
+}
+
+uint64 ICodeGenerator::computeFingerprint() const noexcept
+{
+	uint64 result = HashHelpers::initialHash;
+
+#ifdef RTTI_ENABLED
+	result = HashHelpers::hash(std::string(typeid(*this).name()), result);
+#endif
+
+	result = HashHelpers::combine(result, static_cast<uint64>(getGenerationOrder()));
+
+	return HashHelpers::combine(result, static_cast<uint64>(getIterationCount()));
+}
+
+void ICodeGenerator::resetGenerationState() noexcept
+{
+}
+
+bool ICodeGenerator::supportsReuse() const noexcept
+{
+	return false;
 }
\ No newline at end of file
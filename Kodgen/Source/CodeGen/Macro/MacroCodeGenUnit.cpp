@@ -171,16 +171,19 @@ bool MacroCodeGenUnit::isUpToDate(fs::path const& sourceFile) const noexcept
 	{
 		GeneratedFile generatedHeader(fs::path(generatedHeaderPath), sourceFile);
 	}
-	else if (isFileNewerThan(generatedHeaderPath, sourceFile))
+	else
 	{
-		fs::path generatedSource = getGeneratedSourceFilePath(sourceFile);
-
-		return fs::exists(generatedSource) && isFileNewerThan(generatedSource, sourceFile);
+		return fs::exists(getGeneratedSourceFilePath(sourceFile));
 	}
 
 	return false;
 }
 
+bool MacroCodeGenUnit::supportsReuse() const noexcept
+{
+	return true;
+}
+
 void MacroCodeGenUnit::generateEntityClassFooterCode(EntityInfo const& entity, CodeGenEnv& env, std::function<void(EntityInfo const&, CodeGenEnv&, std::string&)> generate) noexcept
 {
 	if (entity.entityType == EEntityType::Struct || entity.entityType == EEntityType::Class)
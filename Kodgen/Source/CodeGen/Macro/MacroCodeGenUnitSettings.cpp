@@ -6,6 +6,7 @@
 
 #include "Kodgen/InfoStructures/StructClassInfo.h"
 #include "Kodgen/Misc/TomlUtility.h"
+#include "Kodgen/Misc/HashHelpers.h"
 
 using namespace kodgen;
 
@@ -267,4 +268,17 @@ void MacroCodeGenUnitSettings::replaceTags(std::string& inout_string, std::strin
 
 		index = inout_string.find(tag, index + replacement.size());
 	}
+}
+
+uint64 MacroCodeGenUnitSettings::computeFingerprint() const noexcept
+{
+	uint64 result = CodeGenUnitSettings::computeFingerprint();
+
+	result = HashHelpers::hash(_generatedHeaderFileNamePattern, result);
+	result = HashHelpers::hash(_generatedSourceFileNamePattern, result);
+	result = HashHelpers::hash(_classFooterMacroPattern, result);
+	result = HashHelpers::hash(_headerFileFooterMacroPattern, result);
+	result = HashHelpers::hash(_exportSymbolMacroName, result);
+
+	return HashHelpers::hash(_internalSymbolMacroName, result);
 }
\ No newline at end of file
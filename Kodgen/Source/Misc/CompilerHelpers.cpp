@@ -105,36 +105,63 @@ bool CompilerHelpers::isGCC(std::string const& normalizedCompilerExeName) noexce
 
 std::vector<fs::path> CompilerHelpers::getCompilerNativeIncludeDirectories(std::string const& compiler)
 {
-	std::vector<fs::path> result;
-	
 	//Don't do anything if the compiler is an empty string
-	if (compiler.size() > 0)
+	if (compiler.empty())
 	{
-		std::string normalizedCompilerExeName = normalizeCompilerExeName(compiler);
+		return std::vector<fs::path>();
+	}
 
-#if _WIN32
-		//Check MSVC on windows only
-		if (isMSVC(normalizedCompilerExeName))
-		{
-			return getMSVCNativeIncludeDirectories();
-		}
-#endif
+	std::string normalizedCompilerExeName = normalizeCompilerExeName(compiler);
 
-		//Check clang
-		if (isClang(normalizedCompilerExeName))
-		{
-			return getClangNativeIncludeDirectories(normalizedCompilerExeName);
-		}
-		//Check GCC
-		else if (isGCC(normalizedCompilerExeName))
+	{
+		std::lock_guard<std::mutex> lock(_nativeIncludeDirectoriesMutex);
+
+		auto it = _nativeIncludeDirectories.find(normalizedCompilerExeName);
+
+		if (it != _nativeIncludeDirectories.cend())
 		{
-			return getGCCNativeIncludeDirectories(normalizedCompilerExeName);
+			return it->second;
 		}
 	}
 
+	//Running the compiler is slow, don't hold the lock meanwhile
+	std::vector<fs::path> result = queryCompilerNativeIncludeDirectories(normalizedCompilerExeName);
+
+	//Don't remember failed queries so that they are retried next time
+	if (!result.empty())
+	{
+		std::lock_guard<std::mutex> lock(_nativeIncludeDirectoriesMutex);
+
+		_nativeIncludeDirectories.emplace(normalizedCompilerExeName, result);
+	}
+
 	return result;
 }
 
+std::vector<fs::path> CompilerHelpers::queryCompilerNativeIncludeDirectories(std::string const& normalizedCompilerExeName)
+{
+#if _WIN32
+	//Check MSVC on windows only
+	if (isMSVC(normalizedCompilerExeName))
+	{
+		return getMSVCNativeIncludeDirectories();
+	}
+#endif
+
+	//Check clang
+	if (isClang(normalizedCompilerExeName))
+	{
+		return getClangNativeIncludeDirectories(normalizedCompilerExeName);
+	}
+	//Check GCC
+	else if (isGCC(normalizedCompilerExeName))
+	{
+		return getGCCNativeIncludeDirectories(normalizedCompilerExeName);
+	}
+
+	return std::vector<fs::path>();
+}
+
 std::vector<fs::path> CompilerHelpers::getClangNativeIncludeDirectories(std::string const& clangExeName)
 {
 	//Make sure the compiler name actually starts by "clang"
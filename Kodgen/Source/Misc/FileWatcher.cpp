@@ -0,0 +1,196 @@
+#include "Kodgen/Misc/FileWatcher.h"
+
+#if __linux__
+#include <sys/inotify.h>	//inotify_init1, inotify_add_watch, inotify_rm_watch
+#include <poll.h>			//poll
+#include <unistd.h>			//read, close
+#endif
+
+using namespace kodgen;
+
+#if __linux__
+/** Events watched in each directory. */
+static constexpr uint32 const watchedEvents = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+#endif
+
+FileWatcher::FileWatcher(DirectoryFilter directoryFilter) noexcept:
+	_directoryFilter{std::move(directoryFilter)}
+{
+#if __linux__
+	_inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+FileWatcher::~FileWatcher() noexcept
+{
+#if __linux__
+	if (_inotifyDescriptor != -1)
+	{
+		close(_inotifyDescriptor);
+	}
+#endif
+}
+
+bool FileWatcher::isValid() const noexcept
+{
+	return _inotifyDescriptor != -1;
+}
+
+bool FileWatcher::addWatch(fs::path const& directory, bool isRecursive, std::vector<fs::path>* out_existingFiles) noexcept
+{
+#if __linux__
+	int watchDescriptor = inotify_add_watch(_inotifyDescriptor, directory.c_str(), watchedEvents);
+
+	if (watchDescriptor == -1)
+	{
+		return false;
+	}
+
+	//Watching a directory twice returns the same watch descriptor, keep the recursive flag if any
+	WatchedDirectory& watchedDirectory = _watchedDirectories[watchDescriptor];
+
+	watchedDirectory.path			= directory;
+	watchedDirectory.isRecursive	|= isRecursive;
+
+	if (isRecursive || out_existingFiles != nullptr)
+	{
+		//The watch is added before reading the directory so that no file created in the meantime is missed
+		std::vector<DirectoryEntry> entries;
+
+		FilesystemHelpers::readDirectory(directory, entries);
+
+		for (DirectoryEntry const& entry : entries)
+		{
+			fs::path entryPath = directory / entry.name;
+
+			if (entry.isRegularFile && out_existingFiles != nullptr)
+			{
+				out_existingFiles->emplace_back(std::move(entryPath));
+			}
+			else if (entry.isDirectory && isRecursive && (!_directoryFilter || _directoryFilter(entryPath)))
+			{
+				addWatch(entryPath, true, out_existingFiles);
+			}
+		}
+	}
+
+	return true;
+#else
+	(void)directory;
+	(void)isRecursive;
+	(void)out_existingFiles;
+
+	return false;
+#endif
+}
+
+bool FileWatcher::watchDirectory(fs::path const& directory, bool isRecursive) noexcept
+{
+	return isValid() && addWatch(directory, isRecursive, nullptr);
+}
+
+bool FileWatcher::waitForChanges(std::chrono::milliseconds timeout, std::vector<fs::path>& out_changedFiles, bool& out_missedChanges) noexcept
+{
+	if (!isValid())
+	{
+		return false;
+	}
+
+#if __linux__
+	pollfd pollDescriptor{_inotifyDescriptor, POLLIN, 0};
+
+	if (poll(&pollDescriptor, 1, static_cast<int>(timeout.count())) <= 0)
+	{
+		return false;
+	}
+
+	size_t previousChangeCount	= out_changedFiles.size();
+	bool hasMissedChanges		= false;
+
+	alignas(inotify_event) char buffer[_eventBufferSize];
+	ssize_t readSize;
+
+	//The descriptor is non-blocking: read until all pending events have been consumed
+	while ((readSize = read(_inotifyDescriptor, buffer, sizeof(buffer))) > 0)
+	{
+		for (char const* eventPtr = buffer; eventPtr < buffer + readSize; )
+		{
+			inotify_event const* event = reinterpret_cast<inotify_event const*>(eventPtr);
+
+			eventPtr += sizeof(inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW)
+			{
+				hasMissedChanges = true;
+				continue;
+			}
+
+			auto watchedDirectory = _watchedDirectories.find(event->wd);
+
+			if (watchedDirectory == _watchedDirectories.end())
+			{
+				continue;
+			}
+
+			if (event->mask & IN_IGNORED)
+			{
+				//The directory has been removed, or is not reachable anymore
+				_watchedDirectories.erase(watchedDirectory);
+				continue;
+			}
+
+			if (event->len == 0u)
+			{
+				continue;
+			}
+
+			fs::path entryPath = watchedDirectory->second.path / event->name;
+
+			if (!(event->mask & IN_ISDIR))
+			{
+				//The creation of a file is followed by IN_CLOSE_WRITE once its content is written
+				if (!(event->mask & IN_CREATE))
+				{
+					out_changedFiles.emplace_back(std::move(entryPath));
+				}
+			}
+			else if (event->mask & (IN_CREATE | IN_MOVED_TO))
+			{
+				if (watchedDirectory->second.isRecursive && (!_directoryFilter || _directoryFilter(entryPath)))
+				{
+					addWatch(entryPath, true, &out_changedFiles);
+				}
+			}
+			else if (event->mask & IN_MOVED_FROM)
+			{
+				//A moved directory keeps its watch, which would report outdated paths: stop watching it and all its subdirectories.
+				//The directory doesn't exist at this path anymore, so paths are compared lexically
+				std::string directoryPrefix = (entryPath / "").string();
+
+				for (auto it = _watchedDirectories.begin(); it != _watchedDirectories.end(); )
+				{
+					if (it->second.path == entryPath || it->second.path.string().compare(0u, directoryPrefix.size(), directoryPrefix) == 0)
+					{
+						inotify_rm_watch(_inotifyDescriptor, it->first);
+						it = _watchedDirectories.erase(it);
+					}
+					else
+					{
+						++it;
+					}
+				}
+			}
+		}
+	}
+
+	out_missedChanges |= hasMissedChanges;
+
+	return hasMissedChanges || out_changedFiles.size() != previousChangeCount;
+#else
+	(void)timeout;
+	(void)out_changedFiles;
+	(void)out_missedChanges;
+
+	return false;
+#endif
+}
\ No newline at end of file
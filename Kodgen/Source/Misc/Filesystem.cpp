@@ -2,6 +2,12 @@
 
 #include <algorithm> //std::replace
 
+#if !_WIN32
+#include <dirent.h>		//opendir, readdir
+#include <sys/stat.h>	//fstatat
+#include <cstring>		//std::strcmp
+#endif
+
 using namespace kodgen;
 
 fs::path FilesystemHelpers::sanitizePath(fs::path const& path) noexcept
@@ -39,4 +45,83 @@ bool FilesystemHelpers::isChildPath(fs::path const& child, fs::path const& other
 	}
 
 	return false;
+}
+
+bool FilesystemHelpers::readDirectory(fs::path const& directory, std::vector<DirectoryEntry>& out_entries) noexcept
+{
+#if _WIN32
+	//Windows directory iteration already retrieves the file attributes, so directory_entry queries don't require extra system calls
+	std::error_code error;
+
+	for (fs::directory_iterator it(directory, error); !error && it != fs::directory_iterator(); it.increment(error))
+	{
+		DirectoryEntry entry;
+
+		entry.name			= it->path().filename().string();
+		entry.isSymlink		= it->is_symlink(error);
+		entry.isDirectory	= it->is_directory(error);
+		entry.isRegularFile	= it->is_regular_file(error);
+
+		out_entries.emplace_back(std::move(entry));
+	}
+
+	return !error;
+#else
+	DIR* directoryStream = opendir(directory.c_str());
+
+	if (directoryStream == nullptr)
+	{
+		return false;
+	}
+
+	while (dirent* directoryEntry = readdir(directoryStream))
+	{
+		if (std::strcmp(directoryEntry->d_name, ".") == 0 || std::strcmp(directoryEntry->d_name, "..") == 0)
+		{
+			continue;
+		}
+
+		DirectoryEntry entry;
+
+		entry.name = directoryEntry->d_name;
+
+		switch (directoryEntry->d_type)
+		{
+			case DT_DIR:
+				entry.isDirectory = true;
+				break;
+
+			case DT_REG:
+				entry.isRegularFile = true;
+				break;
+
+			case DT_LNK:
+				entry.isSymlink = true;
+				[[fallthrough]];
+
+			case DT_UNKNOWN:
+			{
+				//Follow symlinks, or get the type of the entry if the filesystem doesn't provide it
+				struct stat entryStatus;
+
+				if (fstatat(dirfd(directoryStream), directoryEntry->d_name, &entryStatus, 0) == 0)
+				{
+					entry.isDirectory	= S_ISDIR(entryStatus.st_mode);
+					entry.isRegularFile	= S_ISREG(entryStatus.st_mode);
+				}
+
+				break;
+			}
+
+			default:
+				break;
+		}
+
+		out_entries.emplace_back(std::move(entry));
+	}
+
+	closedir(directoryStream);
+
+	return true;
+#endif
 }
\ No newline at end of file
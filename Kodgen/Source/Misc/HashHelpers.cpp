@@ -0,0 +1,58 @@
+#include "Kodgen/Misc/HashHelpers.h"
+
+#include <array>
+#include <fstream>
+
+using namespace kodgen;
+
+uint64 HashHelpers::hash(void const* data, size_t size, uint64 seed) noexcept
+{
+	constexpr uint64 const fnvPrime = 1099511628211ull;
+
+	unsigned char const* bytes = static_cast<unsigned char const*>(data);
+
+	for (size_t i = 0u; i < size; i++)
+	{
+		seed ^= bytes[i];
+		seed *= fnvPrime;
+	}
+
+	return seed;
+}
+
+uint64 HashHelpers::hash(std::string const& str, uint64 seed) noexcept
+{
+	//Hash the size as well so that ("ab", "c") and ("a", "bc") sequences give different results
+	uint64 size = str.size();
+
+	return hash(str.data(), str.size(), hash(&size, sizeof(size), seed));
+}
+
+uint64 HashHelpers::combine(uint64 seed, uint64 value) noexcept
+{
+	return hash(&value, sizeof(value), seed);
+}
+
+opt::optional<uint64> HashHelpers::hashFileContent(fs::path const& file) noexcept
+{
+	constexpr size_t const bufferSize = 64u * 1024u;
+
+	std::ifstream stream(file, std::ios::in | std::ios::binary);
+
+	if (!stream.is_open())
+	{
+		return opt::nullopt;
+	}
+
+	std::array<char, bufferSize>	buffer;
+	uint64							result = initialHash;
+
+	while (stream)
+	{
+		stream.read(buffer.data(), buffer.size());
+
+		result = hash(buffer.data(), static_cast<size_t>(stream.gcount()), result);
+	}
+
+	return stream.bad() ? opt::nullopt : opt::optional<uint64>(result);
+}
\ No newline at end of file
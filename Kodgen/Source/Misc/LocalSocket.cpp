@@ -0,0 +1,344 @@
+#include "Kodgen/Misc/LocalSocket.h"
+
+#if !_WIN32
+#include <sys/socket.h>	//socket, bind, listen, accept, connect, send, recv
+#include <sys/un.h>		//sockaddr_un
+#include <poll.h>		//poll
+#include <unistd.h>		//close
+#include <cerrno>		//errno
+#include <cstring>		//std::memcpy
+#include <sys/time.h>	//timeval
+#endif
+
+#include <algorithm>	//std::max
+
+using namespace kodgen;
+
+#if !_WIN32
+/**
+*	@brief Fill a Unix socket address with the provided path.
+*
+*	@param path			Path of the socket.
+*	@param out_address	Address to fill.
+*
+*	@return true if the path fits in the address, else false.
+*/
+static bool makeSocketAddress(fs::path const& path, sockaddr_un& out_address) noexcept
+{
+	std::string const& nativePath = path.native();
+
+	//Keep room for the null terminator
+	if (nativePath.empty() || nativePath.size() >= sizeof(out_address.sun_path))
+	{
+		return false;
+	}
+
+	out_address = sockaddr_un{};
+	out_address.sun_family = AF_UNIX;
+	std::memcpy(out_address.sun_path, nativePath.c_str(), nativePath.size() + 1u);
+
+	return true;
+}
+
+/**
+*	@brief Check whether a path is a socket file left by a listening socket which doesn't exist anymore.
+*
+*	@param path		Path of the socket.
+*	@param address	Address of the socket.
+*
+*	@return true if nothing listens to the socket file at path anymore, else false.
+*/
+static bool isStaleSocket(fs::path const& path, sockaddr_un const& address) noexcept
+{
+	std::error_code error;
+
+	if (!fs::is_socket(path, error))
+	{
+		return false;
+	}
+
+	int		descriptor	= socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	bool	isStale		= descriptor != -1 && connect(descriptor, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0 && errno == ECONNREFUSED;
+
+	if (descriptor != -1)
+	{
+		close(descriptor);
+	}
+
+	return isStale;
+}
+#endif
+
+LocalSocket::LocalSocket(LocalSocket&& other) noexcept:
+	_descriptor{other._descriptor},
+	_boundPath{std::move(other._boundPath)},
+	_receivedData{std::move(other._receivedData)},
+	_timeout{other._timeout},
+	_maxLineLength{other._maxLineLength}
+{
+	other._descriptor = -1;
+	other._boundPath.clear();
+}
+
+LocalSocket::~LocalSocket() noexcept
+{
+	close();
+}
+
+bool LocalSocket::listen(fs::path const& path) noexcept
+{
+	close();
+
+#if _WIN32
+	(void)path;
+
+	return false;
+#else
+	sockaddr_un address;
+
+	if (!makeSocketAddress(path, address))
+	{
+		return false;
+	}
+
+	_descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+	if (_descriptor == -1)
+	{
+		return false;
+	}
+
+	//A socket file left by a server which didn't exit properly would make bind fail, but the socket of a running server
+	//or any other file at this path must be kept: bind then fails
+	std::error_code error;
+
+	if (isStaleSocket(path, address))
+	{
+		fs::remove(path, error);
+	}
+
+	if (bind(_descriptor, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0 ||
+		::listen(_descriptor, SOMAXCONN) != 0)
+	{
+		close();
+
+		return false;
+	}
+
+	_boundPath = path;
+
+	return true;
+#endif
+}
+
+bool LocalSocket::accept(std::chrono::milliseconds timeout, LocalSocket& out_client) noexcept
+{
+#if _WIN32
+	(void)timeout;
+	(void)out_client;
+
+	return false;
+#else
+	pollfd pollDescriptor{_descriptor, POLLIN, 0};
+
+	if (!isValid() || poll(&pollDescriptor, 1, static_cast<int>(timeout.count())) <= 0)
+	{
+		return false;
+	}
+
+	int clientDescriptor = ::accept4(_descriptor, nullptr, nullptr, SOCK_CLOEXEC);
+
+	if (clientDescriptor == -1)
+	{
+		return false;
+	}
+
+	out_client.close();
+	out_client._descriptor = clientDescriptor;
+
+	return true;
+#endif
+}
+
+bool LocalSocket::connect(fs::path const& path) noexcept
+{
+	close();
+
+#if _WIN32
+	(void)path;
+
+	return false;
+#else
+	sockaddr_un address;
+
+	if (!makeSocketAddress(path, address))
+	{
+		return false;
+	}
+
+	_descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+	if (_descriptor == -1 || ::connect(_descriptor, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0)
+	{
+		close();
+
+		return false;
+	}
+
+	return true;
+#endif
+}
+
+bool LocalSocket::send(std::string const& data) noexcept
+{
+#if _WIN32
+	(void)data;
+
+	return false;
+#else
+	size_t sentSize = 0u;
+
+	while (sentSize < data.size())
+	{
+		//Don't raise SIGPIPE if the peer closed the connection, report the failure instead
+		ssize_t result = ::send(_descriptor, data.data() + sentSize, data.size() - sentSize, MSG_NOSIGNAL);
+
+		if (result < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			return false;
+		}
+
+		sentSize += static_cast<size_t>(result);
+	}
+
+	return true;
+#endif
+}
+
+bool LocalSocket::setLimits(std::chrono::milliseconds timeout, size_t maxLineLength) noexcept
+{
+	_timeout		= timeout;
+	_maxLineLength	= maxLineLength;
+
+#if _WIN32
+	return false;
+#else
+	//receiveLine polls with the remaining time of the whole line, send relies on the socket option
+	timeval sendTimeout{};
+	sendTimeout.tv_sec	= static_cast<time_t>(timeout.count() / 1000);
+	sendTimeout.tv_usec	= static_cast<suseconds_t>((timeout.count() % 1000) * 1000);
+
+	return isValid() && setsockopt(_descriptor, SOL_SOCKET, SO_SNDTIMEO, &sendTimeout, sizeof(sendTimeout)) == 0;
+#endif
+}
+
+bool LocalSocket::receiveLine(std::string& out_line) noexcept
+{
+#if _WIN32
+	(void)out_line;
+
+	return false;
+#else
+	auto const	deadline = std::chrono::steady_clock::now() + _timeout;
+	size_t		lineEnd;
+
+	while ((lineEnd = _receivedData.find('\n')) == std::string::npos)
+	{
+		if (_maxLineLength != 0u && _receivedData.size() > _maxLineLength)
+		{
+			return false;
+		}
+
+		if (_timeout.count() != 0)
+		{
+			auto	remainingTime	= std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+			pollfd	pollDescriptor{_descriptor, POLLIN, 0};
+			int		pollResult		= poll(&pollDescriptor, 1, static_cast<int>(std::max<std::chrono::milliseconds::rep>(remainingTime.count(), 0)));
+
+			if (pollResult < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			else if (pollResult <= 0)
+			{
+				//The peer didn't send a full line in time
+				return false;
+			}
+		}
+
+		char	buffer[4096];
+		ssize_t	result = ::recv(_descriptor, buffer, sizeof(buffer), 0);
+
+		if (result < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		else if (result <= 0)
+		{
+			return false;
+		}
+
+		_receivedData.append(buffer, static_cast<size_t>(result));
+	}
+
+	if (_maxLineLength != 0u && lineEnd > _maxLineLength)
+	{
+		return false;
+	}
+
+	out_line.assign(_receivedData, 0u, lineEnd);
+	_receivedData.erase(0u, lineEnd + 1u);
+
+	return true;
+#endif
+}
+
+void LocalSocket::close() noexcept
+{
+#if !_WIN32
+	if (_descriptor != -1)
+	{
+		::close(_descriptor);
+		_descriptor = -1;
+	}
+#endif
+
+	if (!_boundPath.empty())
+	{
+		std::error_code error;
+		fs::remove(_boundPath, error);
+
+		_boundPath.clear();
+	}
+
+	_receivedData.clear();
+}
+
+bool LocalSocket::isValid() const noexcept
+{
+	return _descriptor != -1;
+}
+
+LocalSocket& LocalSocket::operator=(LocalSocket&& other) noexcept
+{
+	if (this != &other)
+	{
+		close();
+
+		_descriptor		= other._descriptor;
+		_boundPath		= std::move(other._boundPath);
+		_receivedData	= std::move(other._receivedData);
+		_timeout		= other._timeout;
+		_maxLineLength	= other._maxLineLength;
+
+		other._descriptor = -1;
+		other._boundPath.clear();
+	}
+
+	return *this;
+}
\ No newline at end of file
@@ -1,44 +1,127 @@
 #include "Kodgen/Parsing/FileParser.h"
 
 #include <cassert>
+#include <algorithm>	//std::sort, std::unique, std::remove, std::any_of, std::none_of, std::find
+#include <unordered_set>
+#include <limits>
 
 #include "Kodgen/Misc/Helpers.h"
+#include "Kodgen/Misc/HashHelpers.h"
 #include "Kodgen/Misc/DisableWarningMacros.h"
 #include "Kodgen/Misc/TomlUtility.h"
 
 using namespace kodgen;
 
+/**
+*	@brief Get the absolute path of a file which may only exist in memory.
+*
+*	@param path Path to the file.
+*
+*	@return The sanitized path if the file exists on the disk, else the normalized absolute path.
+*/
+static fs::path getAbsolutePath(fs::path const& path) noexcept
+{
+	std::error_code errorCode;
+
+	return fs::exists(path, errorCode) ? FilesystemHelpers::sanitizePath(path) : fs::absolute(path, errorCode).lexically_normal().make_preferred();
+}
+
+/**
+*	@brief Check whether a precompiled header includes a file which is written during the generation.
+*
+*	@param precompiledHeader	The precompiled header to check.
+*	@param toParseFiles			Files which are about to be parsed, and generated.
+*	@param generatedDirectories	Directories which files are written during the generation.
+*
+*	@return true if the precompiled header includes any of the provided files or any file of the provided directories, else false.
+*/
+static bool includesGeneratedFile(PrecompiledHeader const& precompiledHeader, std::vector<fs::path> const& toParseFiles, std::vector<fs::path> const& generatedDirectories) noexcept
+{
+	std::unordered_set<fs::path, PathHash> generatedFiles;
+
+	for (fs::path const& file : toParseFiles)
+	{
+		generatedFiles.emplace(FilesystemHelpers::sanitizePath(file));
+	}
+
+	return std::any_of(precompiledHeader.getIncludedFiles().cbegin(), precompiledHeader.getIncludedFiles().cend(), [&](fs::path const& includedFile)
+					   {
+						   return generatedFiles.count(includedFile) != 0u ||
+								  std::any_of(generatedDirectories.cbegin(), generatedDirectories.cend(), [&includedFile](fs::path const& directory)
+											  {
+												  return FilesystemHelpers::isChildPath(includedFile, directory);
+											  });
+					   });
+}
+
+/**
+*	Data filled while looking for the headers included by a precompiled header prelude which have no include guard.
+*/
+struct UnguardedIncludeSearch
+{
+	/** Translation unit of the prelude. */
+	CXTranslationUnit	translationUnit		= nullptr;
+
+	/** Index of the first prelude include directive including a header without include guard. */
+	size_t				firstUnguardedIndex	= std::numeric_limits<size_t>::max();
+
+	/** Header included by the include directive at firstUnguardedIndex. */
+	std::string			unguardedHeader;
+};
+
+/**
+*	@brief	Called for each file included by a precompiled header prelude, which includes a single file per line.
+*			Fill the UnguardedIncludeSearch provided as client data if the file is directly included by the prelude without include guard.
+*/
+static void findUnguardedInclude(CXFile includedFile, CXSourceLocation* inclusionStack, unsigned int includeLength, CXClientData clientData) noexcept
+{
+	UnguardedIncludeSearch* search = reinterpret_cast<UnguardedIncludeSearch*>(clientData);
+
+	if (includeLength == 1u && clang_isFileMultipleIncludeGuarded(search->translationUnit, includedFile) == 0u)
+	{
+		unsigned int line = 0u;
+
+		clang_getSpellingLocation(inclusionStack[0], nullptr, &line, nullptr, nullptr);
+
+		if (line != 0u && line - 1u < search->firstUnguardedIndex)
+		{
+			search->firstUnguardedIndex	= line - 1u;
+			search->unguardedHeader		= Helpers::getString(clang_getFileName(includedFile));
+		}
+	}
+}
+
 FileParser::FileParser() noexcept:
-	_clangIndex{clang_createIndex(0, 0)},
+	_clangIndex{clang_createIndex(0, 0), &clang_disposeIndex},
 	_settings{std::make_shared<ParsingSettings>()},
+	_translationUnitCache{std::make_shared<TranslationUnitCache>()},
 	logger{nullptr}
 {
 }
 
 FileParser::FileParser(FileParser const& other) noexcept:
 	NamespaceParser(other),
-	_clangIndex{clang_createIndex(0, 0)},	//Don't copy clang index, create a new one
+	_clangIndex{clang_createIndex(0, 0), &clang_disposeIndex},	//Don't copy clang index, create a new one
 	_settings{other._settings},
+	_precompiledHeader{other._precompiledHeader},
+	_translationUnitCache{other._translationUnitCache},
 	logger{other.logger}
 {
 }
 
 FileParser::FileParser(FileParser&& other) noexcept:
 	NamespaceParser(std::forward<NamespaceParser>(other)),
-	_clangIndex{std::forward<CXIndex>(other._clangIndex)},
+	_clangIndex{std::move(other._clangIndex)},
 	_propertyParser(std::forward<PropertyParser>(other._propertyParser)),
 	_settings{other._settings},
+	_precompiledHeader{std::move(other._precompiledHeader)},
+	_translationUnitCache{std::move(other._translationUnitCache)},
 	logger{other.logger}
 {
-	other._clangIndex = nullptr;
 }
 
 FileParser::~FileParser() noexcept
 {
-	if (_clangIndex != nullptr)
-	{
-		clang_disposeIndex(_clangIndex);
-	}
 }
 
 bool FileParser::parse(fs::path const& toParseFile, FileParsingResult& out_result) noexcept
@@ -54,50 +137,343 @@ bool FileParser::parse(fs::path const& toParseFile, FileParsingResult& out_resul
 		//Fill the parsed file info
 		out_result.parsedFile = FilesystemHelpers::sanitizePath(toParseFile);
 
-		//Parse the given file
-		CXTranslationUnit translationUnit = clang_parseTranslationUnit(_clangIndex, toParseFile.string().c_str(), _settings->getCompilationArguments().data(), static_cast<int32>(_settings->getCompilationArguments().size()), nullptr, 0, CXTranslationUnit_SkipFunctionBodies | CXTranslationUnit_Incomplete | CXTranslationUnit_KeepGoing);
+		//Load the precompiled header instead of parsing the prelude if the file starts with it
+		std::shared_ptr<PrecompiledHeader>	precompiledHeader = (_precompiledHeader != nullptr && _precompiledHeader->appliesTo(toParseFile)) ? _precompiledHeader : nullptr;
+		std::vector<CXUnsavedFile>			unsavedFiles;
+
+		isSuccess = parseTranslationUnit(toParseFile.string(), unsavedFiles, precompiledHeader, out_result);
+	}
+	else
+	{
+		out_result.errors.emplace_back("File " + toParseFile.string() + " doesn't exist.");
+	}
+
+	postParse(toParseFile, out_result);
+
+	return isSuccess;
+}
+
+bool FileParser::parse(fs::path const& toParseFile, std::string const& fileContent, std::vector<UnsavedFile> const& unsavedFiles, FileParsingResult& out_result) noexcept
+{
+	assert(_settings.use_count() != 0);
+
+	preParse(toParseFile);
+
+	//Fill the parsed file info, the file may only exist in memory
+	out_result.parsedFile = getAbsolutePath(toParseFile);
+
+	//libclang keeps pointers to the file paths, so they must not be reallocated
+	std::string					parsedFilePath = out_result.parsedFile.string();
+	std::vector<std::string>	unsavedFilePaths;
+	std::vector<CXUnsavedFile>	clangUnsavedFiles;
+
+	unsavedFilePaths.reserve(unsavedFiles.size());
+	clangUnsavedFiles.reserve(unsavedFiles.size() + 1u);
+
+	clangUnsavedFiles.push_back(CXUnsavedFile{ parsedFilePath.c_str(), fileContent.data(), static_cast<unsigned long>(fileContent.size()) });
+
+	for (UnsavedFile const& unsavedFile : unsavedFiles)
+	{
+		unsavedFilePaths.emplace_back(getAbsolutePath(unsavedFile.path).string());
+
+		clangUnsavedFiles.push_back(CXUnsavedFile{ unsavedFilePaths.back().c_str(), unsavedFile.content.data(), static_cast<unsigned long>(unsavedFile.content.size()) });
+	}
+
+	//The precompiled header can't be used if it has been built from the disk version of an unsaved file
+	std::shared_ptr<PrecompiledHeader> precompiledHeader;
+
+	if (_precompiledHeader != nullptr && _precompiledHeader->appliesTo(out_result.parsedFile, fileContent) &&
+		std::none_of(unsavedFilePaths.cbegin(), unsavedFilePaths.cend(), [this](std::string const& unsavedFilePath)
+					 {
+						 return std::find(_precompiledHeader->getIncludedFiles().cbegin(), _precompiledHeader->getIncludedFiles().cend(), fs::path(unsavedFilePath)) != _precompiledHeader->getIncludedFiles().cend();
+					 }))
+	{
+		precompiledHeader = _precompiledHeader;
+	}
+
+	bool isSuccess = parseTranslationUnit(parsedFilePath, clangUnsavedFiles, precompiledHeader, out_result);
+
+	postParse(toParseFile, out_result);
+
+	return isSuccess;
+}
+
+bool FileParser::parseTranslationUnit(std::string const& toParseFile, std::vector<CXUnsavedFile>& unsavedFiles, std::shared_ptr<PrecompiledHeader> const& precompiledHeader, FileParsingResult& out_result) noexcept
+{
+	bool isSuccess = false;
+
+	std::vector<char const*>	compilationArguments = _settings->getCompilationArguments();
+	std::string					precompiledHeaderPath;
+
+	//Load the precompiled header instead of parsing the prelude
+	if (precompiledHeader != nullptr)
+	{
+		precompiledHeaderPath = precompiledHeader->getFile().string();
+
+		compilationArguments.emplace_back("-include-pch");
+		compilationArguments.emplace_back(precompiledHeaderPath.c_str());
+	}
+
+	CXTranslationUnit		translationUnit			= nullptr;
+	std::shared_ptr<void>	clangIndex				= _clangIndex;
+	uint64					argumentsFingerprint	= HashHelpers::initialHash;
 
-		if (translationUnit != nullptr)
+	if (_settings->shouldReuseTranslationUnits)
+	{
+		for (char const* compilationArgument : compilationArguments)
 		{
-			ParsingContext& context = pushContext(translationUnit, out_result);
+			argumentsFingerprint = HashHelpers::hash(std::string(compilationArgument), argumentsFingerprint);
+		}
+
+		translationUnit = _translationUnitCache->acquire(out_result.parsedFile, argumentsFingerprint, clangIndex);
+
+		//libclang only parses again the part of the file following its preamble if the preamble didn't change
+		if (translationUnit != nullptr && clang_reparseTranslationUnit(translationUnit, static_cast<unsigned int>(unsavedFiles.size()), unsavedFiles.data(), clang_defaultReparseOptions(translationUnit)) != 0)
+		{
+			//A translation unit which failed to be reparsed can only be disposed
+			clang_disposeTranslationUnit(translationUnit);
+
+			translationUnit	= nullptr;
+			clangIndex		= _clangIndex;
+		}
+	}
+
+	//Parse the given file
+	if (translationUnit == nullptr)
+	{
+		unsigned int parsingOptions = _settings->shouldReuseTranslationUnits ? _parsingOptions | CXTranslationUnit_PrecompiledPreamble : _parsingOptions;
+
+		translationUnit = clang_parseTranslationUnit(_clangIndex.get(), toParseFile.c_str(), compilationArguments.data(), static_cast<int32>(compilationArguments.size()), unsavedFiles.data(), static_cast<unsigned int>(unsavedFiles.size()), parsingOptions);
+	}
 
-			if (clang_visitChildren(context.rootCursor, &FileParser::parseNestedEntity, this) || !out_result.errors.empty())
+	if (translationUnit != nullptr)
+	{
+		ParsingContext& context = pushContext(translationUnit, out_result);
+
+		if (clang_visitChildren(context.rootCursor, &FileParser::parseNestedEntity, this) || !out_result.errors.empty())
+		{
+			//ERROR
+		}
+		else
+		{
+			//Refresh all outer entities contained in the final result
+			refreshOuterEntity(out_result);
+
+			isSuccess = true;
+		}
+
+		//Collect all headers this file depends on
+		//A file without include guard can be reported multiple times, so remove duplicates
+		clang_getInclusions(translationUnit, &FileParser::collectInclusion, &out_result);
+
+		//Files included by the precompiled header are not reported by libclang,
+		//but its prelude is once a reused translation unit has been reparsed
+		if (precompiledHeader != nullptr)
+		{
+			fs::path preludeFile = FilesystemHelpers::sanitizePath(precompiledHeader->getPreludeFile());
+
+			out_result.includedFiles.erase(std::remove(out_result.includedFiles.begin(), out_result.includedFiles.end(), preludeFile), out_result.includedFiles.end());
+			out_result.includedFiles.insert(out_result.includedFiles.end(), precompiledHeader->getIncludedFiles().cbegin(), precompiledHeader->getIncludedFiles().cend());
+		}
+
+		std::sort(out_result.includedFiles.begin(), out_result.includedFiles.end());
+		out_result.includedFiles.erase(std::unique(out_result.includedFiles.begin(), out_result.includedFiles.end()), out_result.includedFiles.end());
+
+		out_result.hasCompilationErrors = hasErrorDiagnostic(translationUnit);
+
+		popContext();
+
+		//There should not have any context left once parsing has finished
+		assert(contextsStack.empty());
+
+		if (_settings->shouldLogDiagnostic)
+		{
+			logDiagnostic(translationUnit);
+		}
+
+		if (_settings->shouldReuseTranslationUnits)
+		{
+			_translationUnitCache->release(out_result.parsedFile, translationUnit, std::move(clangIndex), argumentsFingerprint, static_cast<uint64>(_settings->translationUnitCacheMemoryLimit) * 1024u * 1024u);
+		}
+		else
+		{
+			clang_disposeTranslationUnit(translationUnit);
+		}
+	}
+	else
+	{
+		out_result.errors.emplace_back("Failed to initialize translation unit for file: " + toParseFile);
+	}
+
+	return isSuccess;
+}
+
+bool FileParser::preparePrecompiledHeader(std::vector<fs::path> const& toParseFiles, std::vector<fs::path> const& generatedDirectories) noexcept
+{
+	if (!_settings->shouldUsePrecompiledHeader)
+	{
+		_precompiledHeader.reset();
+
+		return false;
+	}
+
+	//A precompiled header can only be loaded with the compilation arguments it has been built with
+	uint64 fingerprint = HashHelpers::initialHash;
+
+	for (char const* compilationArgument : _settings->getCompilationArguments())
+	{
+		fingerprint = HashHelpers::hash(std::string(compilationArgument), fingerprint);
+	}
+
+	bool						isForced = !_settings->precompiledHeaderPrelude.empty();
+	std::vector<std::string>	preludeIncludes;
+
+	if (isForced)
+	{
+		fs::path prelude = FilesystemHelpers::sanitizePath(_settings->precompiledHeaderPrelude);
+
+		if (prelude.empty())
+		{
+			if (logger != nullptr)
 			{
-				//ERROR
+				logger->log("Precompiled header prelude " + _settings->precompiledHeaderPrelude.string() + " doesn't exist.", ILogger::ELogSeverity::Warning);
 			}
-			else
-			{
-				//Refresh all outer entities contained in the final result
-				refreshOuterEntity(out_result);
 
-				isSuccess = true;
-			}
+			_precompiledHeader.reset();
 
-			popContext();
+			return false;
+		}
 
-			//There should not have any context left once parsing has finished
-			assert(contextsStack.empty());
+		preludeIncludes.emplace_back("\"" + FilesystemHelpers::normalizeSeparator(prelude).string() + "\"");
+	}
 
-			if (_settings->shouldLogDiagnostic)
+	//Keep the current precompiled header while it is up to date, so that generations of a few files (in watch mode) benefit from it as well
+	if (_precompiledHeader != nullptr &&
+		_precompiledHeader->getFingerprint() == fingerprint &&
+		_precompiledHeader->isForced() == isForced &&
+		(!isForced || _precompiledHeader->getPreludeIncludes() == preludeIncludes) &&
+		_precompiledHeader->isUpToDate() &&
+		!includesGeneratedFile(*_precompiledHeader, toParseFiles, generatedDirectories))
+	{
+		return true;
+	}
+
+	_precompiledHeader.reset();
+
+	if (!isForced)
+	{
+		preludeIncludes = PrecompiledHeader::findCommonIncludePrefix(toParseFiles);
+	}
+
+	//A prelude including generated files can't be precompiled, retry with the first half of the prelude since only the included files are known
+	while (!preludeIncludes.empty())
+	{
+		std::shared_ptr<PrecompiledHeader> precompiledHeader = buildPrecompiledHeader(preludeIncludes, isForced, fingerprint);
+
+		if (precompiledHeader == nullptr)
+		{
+			break;
+		}
+		else if (!includesGeneratedFile(*precompiledHeader, toParseFiles, generatedDirectories))
+		{
+			_precompiledHeader = std::move(precompiledHeader);
+
+			return true;
+		}
+		else if (isForced)
+		{
+			if (logger != nullptr)
 			{
-				logDiagnostic(translationUnit);
+				logger->log("Precompiled header prelude " + _settings->precompiledHeaderPrelude.string() + " includes files written during the generation, files are parsed without precompiled header.", ILogger::ELogSeverity::Warning);
 			}
 
-			clang_disposeTranslationUnit(translationUnit);
+			break;
 		}
-		else
+
+		preludeIncludes.resize(preludeIncludes.size() / 2u);
+	}
+
+	return false;
+}
+
+std::shared_ptr<PrecompiledHeader> FileParser::buildPrecompiledHeader(std::vector<std::string> preludeIncludes, bool isForced, uint64 fingerprint) noexcept
+{
+	std::shared_ptr<PrecompiledHeader> result = std::make_shared<PrecompiledHeader>(std::move(preludeIncludes), isForced, fingerprint);
+
+	if (!result->writePrelude())
+	{
+		if (logger != nullptr)
 		{
-			out_result.errors.emplace_back("Failed to initialize translation unit for file: " + toParseFile.string());
+			logger->log("Failed to write the precompiled header prelude " + result->getPreludeFile().string(), ILogger::ELogSeverity::Warning);
 		}
+
+		return nullptr;
 	}
-	else
+
+	CXTranslationUnit translationUnit = clang_parseTranslationUnit(_clangIndex.get(), result->getPreludeFile().string().c_str(), _settings->getCompilationArguments().data(), static_cast<int32>(_settings->getCompilationArguments().size()), nullptr, 0, _parsingOptions | CXTranslationUnit_ForSerialization);
+
+	if (translationUnit == nullptr)
 	{
-		out_result.errors.emplace_back("File " + toParseFile.string() + " doesn't exist.");
+		if (logger != nullptr)
+		{
+			logger->log("Failed to initialize translation unit for precompiled header prelude: " + result->getPreludeFile().string(), ILogger::ELogSeverity::Warning);
+		}
+
+		return nullptr;
 	}
 
-	postParse(toParseFile, out_result);
+	//Parsed files include again their leading headers after the precompiled header,
+	//so the prelude must stop before the first header which would then be included twice
+	UnguardedIncludeSearch unguardedIncludeSearch;
+	unguardedIncludeSearch.translationUnit = translationUnit;
 
-	return isSuccess;
+	clang_getInclusions(translationUnit, &findUnguardedInclude, &unguardedIncludeSearch);
+
+	if (unguardedIncludeSearch.firstUnguardedIndex < result->getPreludeIncludes().size())
+	{
+		clang_disposeTranslationUnit(translationUnit);
+
+		if (logger != nullptr)
+		{
+			logger->log("Header " + unguardedIncludeSearch.unguardedHeader + " has no include guard, it is left out of the precompiled header.", ILogger::ELogSeverity::Info);
+		}
+
+		std::vector<std::string> guardedIncludes(result->getPreludeIncludes().cbegin(), result->getPreludeIncludes().cbegin() + unguardedIncludeSearch.firstUnguardedIndex);
+
+		return guardedIncludes.empty() ? nullptr : buildPrecompiledHeader(std::move(guardedIncludes), isForced, fingerprint);
+	}
+
+	//Files included by the precompiled header are then added to the dependencies of the files parsed with it
+	FileParsingResult inclusions;
+
+	clang_getInclusions(translationUnit, &FileParser::collectInclusion, &inclusions);
+
+	std::sort(inclusions.includedFiles.begin(), inclusions.includedFiles.end());
+	inclusions.includedFiles.erase(std::unique(inclusions.includedFiles.begin(), inclusions.includedFiles.end()), inclusions.includedFiles.end());
+
+	//libclang refuses to save translation units with errors
+	bool isSaved = clang_saveTranslationUnit(translationUnit, result->getFile().string().c_str(), clang_defaultSaveOptions(translationUnit)) == CXSaveError_None;
+
+	if (!isSaved && _settings->shouldLogDiagnostic)
+	{
+		logDiagnostic(translationUnit);
+	}
+
+	clang_disposeTranslationUnit(translationUnit);
+
+	if (!isSaved)
+	{
+		if (logger != nullptr)
+		{
+			logger->log("Failed to build the precompiled header of prelude " + result->getPreludeFile().string() + ", files are parsed without precompiled header.", ILogger::ELogSeverity::Warning);
+		}
+
+		return nullptr;
+	}
+
+	result->onBuilt(std::move(inclusions.includedFiles));
+
+	return result;
 }
 
 CXChildVisitResult FileParser::parseNestedEntity(CXCursor cursor, CXCursor /* parentCursor */, CXClientData clientData) noexcept
@@ -150,6 +526,55 @@ CXChildVisitResult FileParser::parseNestedEntity(CXCursor cursor, CXCursor /* pa
 	return visitResult;
 }
 
+void FileParser::collectInclusion(CXFile includedFile, CXSourceLocation* /* inclusionStack */, unsigned int includeLength, CXClientData clientData) noexcept
+{
+	//The main file is reported with an empty inclusion stack, skip it
+	if (includeLength != 0u)
+	{
+		FileParsingResult*	result		= reinterpret_cast<FileParsingResult*>(clientData);
+		fs::path			realPath	= Helpers::getString(clang_File_tryGetRealPathName(includedFile));
+		std::error_code		errorCode;
+
+		//Prefer the real path to get a single spelling for each file, whatever the include directories used to reach it.
+		//libclang computes the real path of the files of a reused precompiled preamble lexically, which is wrong for paths
+		//going through symbolic links, so resolve the file name through the filesystem when the real path doesn't exist
+		if (realPath.empty() || !fs::exists(realPath, errorCode))
+		{
+			fs::path fileName = Helpers::getString(clang_getFileName(includedFile));
+
+			realPath = FilesystemHelpers::sanitizePath(fileName);
+
+			//Files which only exist in memory keep their name
+			if (realPath.empty())
+			{
+				realPath = std::move(fileName);
+			}
+		}
+
+		result->includedFiles.emplace_back(std::move(realPath));
+	}
+}
+
+bool FileParser::hasErrorDiagnostic(CXTranslationUnit const& translationUnit) noexcept
+{
+	unsigned int diagnosticsCount = clang_getNumDiagnostics(translationUnit);
+
+	for (unsigned int i = 0u; i < diagnosticsCount; i++)
+	{
+		CXDiagnostic			diagnostic	= clang_getDiagnostic(translationUnit, i);
+		CXDiagnosticSeverity	severity	= clang_getDiagnosticSeverity(diagnostic);
+
+		clang_disposeDiagnostic(diagnostic);
+
+		if (severity >= CXDiagnostic_Error)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 ParsingContext& FileParser::pushContext(CXTranslationUnit const& translationUnit, FileParsingResult& out_result) noexcept
 {
 	_propertyParser.setup(_settings->propertyParsingSettings);
@@ -4,6 +4,7 @@
 #include "Kodgen/Misc/TomlUtility.h"
 #include "Kodgen/Misc/ILogger.h"
 #include "Kodgen/Misc/Helpers.h"
+#include "Kodgen/Misc/HashHelpers.h"
 
 using namespace kodgen;
 
@@ -142,6 +143,8 @@ bool ParsingSettings::loadSettingsValues(toml::value const& tomlData, ILogger* l
 		loadShouldLogDiagnostic(tomlParsingSettings, logger);
 		loadCompilerExeName(tomlParsingSettings, logger);
 		loadProjectIncludeDirectories(tomlParsingSettings, logger);
+		loadPrecompiledHeaderSettings(tomlParsingSettings, logger);
+		loadTranslationUnitReuseSettings(tomlParsingSettings, logger);
 
 		return propertyParsingSettings.loadSettingsValues(tomlParsingSettings, logger);
 	}
@@ -298,6 +301,32 @@ void ParsingSettings::loadProjectIncludeDirectories(toml::value const& parsingSe
 	}
 }
 
+void ParsingSettings::loadPrecompiledHeaderSettings(toml::value const& parsingSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(parsingSettings, "shouldUsePrecompiledHeader", shouldUsePrecompiledHeader, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldUsePrecompiledHeader: " + Helpers::toString(shouldUsePrecompiledHeader));
+	}
+
+	if (TomlUtility::updateSetting(parsingSettings, "precompiledHeaderPrelude", precompiledHeaderPrelude, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load precompiledHeaderPrelude: " + precompiledHeaderPrelude.string());
+	}
+}
+
+void ParsingSettings::loadTranslationUnitReuseSettings(toml::value const& parsingSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(parsingSettings, "shouldReuseTranslationUnits", shouldReuseTranslationUnits, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldReuseTranslationUnits: " + Helpers::toString(shouldReuseTranslationUnits));
+	}
+
+	if (TomlUtility::updateSetting(parsingSettings, "translationUnitCacheMemoryLimit", translationUnitCacheMemoryLimit, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load translationUnitCacheMemoryLimit: " + std::to_string(translationUnitCacheMemoryLimit) + "MB");
+	}
+}
+
 bool ParsingSettings::addProjectIncludeDirectory(fs::path const& directoryPath) noexcept
 {
 	fs::path sanitizedPath = FilesystemHelpers::sanitizePath(directoryPath);
@@ -345,4 +374,51 @@ bool ParsingSettings::setCompilerExeName(std::string const& compilerExeName) noe
 	}
 
 	return false;
+}
+
+uint64 ParsingSettings::computeFingerprint() const noexcept
+{
+	uint64 result = HashHelpers::initialHash;
+
+	result = HashHelpers::combine(result, static_cast<uint64>(cppVersion));
+	result = HashHelpers::hash(_compilerExeName, result);
+
+	//Pack all boolean settings in a single value
+	uint64 flags =	(static_cast<uint64>(shouldParseAllNamespaces)			<< 0u) |
+					(static_cast<uint64>(shouldParseAllClasses)				<< 1u) |
+					(static_cast<uint64>(shouldParseAllStructs)				<< 2u) |
+					(static_cast<uint64>(shouldParseAllVariables)			<< 3u) |
+					(static_cast<uint64>(shouldParseAllFields)				<< 4u) |
+					(static_cast<uint64>(shouldParseAllFunctions)			<< 5u) |
+					(static_cast<uint64>(shouldParseAllMethods)				<< 6u) |
+					(static_cast<uint64>(shouldParseAllEnums)				<< 7u) |
+					(static_cast<uint64>(shouldParseAllEnumValues)			<< 8u) |
+					(static_cast<uint64>(shouldAbortParsingOnFirstError)	<< 9u);
+
+	result = HashHelpers::combine(result, flags);
+
+	//Property settings end up in the compilation arguments (macro definitions) and drive the property parsing
+	result = HashHelpers::combine(result, static_cast<uint64>(propertyParsingSettings.propertySeparator));
+	result = HashHelpers::combine(result, static_cast<uint64>(propertyParsingSettings.argumentSeparator));
+	result = HashHelpers::combine(result, static_cast<uint64>(propertyParsingSettings.argumentEnclosers[0]));
+	result = HashHelpers::combine(result, static_cast<uint64>(propertyParsingSettings.argumentEnclosers[1]));
+	result = HashHelpers::hash(propertyParsingSettings.namespaceMacroName, result);
+	result = HashHelpers::hash(propertyParsingSettings.classMacroName, result);
+	result = HashHelpers::hash(propertyParsingSettings.structMacroName, result);
+	result = HashHelpers::hash(propertyParsingSettings.variableMacroName, result);
+	result = HashHelpers::hash(propertyParsingSettings.fieldMacroName, result);
+	result = HashHelpers::hash(propertyParsingSettings.functionMacroName, result);
+	result = HashHelpers::hash(propertyParsingSettings.methodMacroName, result);
+	result = HashHelpers::hash(propertyParsingSettings.enumMacroName, result);
+	result = HashHelpers::hash(propertyParsingSettings.enumValueMacroName, result);
+
+	//Include directories are stored in an unordered set, so combine them in an order independent way
+	uint64 includeDirectoriesHash = 0u;
+
+	for (fs::path const& includeDir : _projectIncludeDirectories)
+	{
+		includeDirectoriesHash ^= HashHelpers::hash(includeDir.string());
+	}
+
+	return HashHelpers::combine(result, includeDirectoriesHash);
 }
\ No newline at end of file
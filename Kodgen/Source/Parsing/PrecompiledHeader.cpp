@@ -0,0 +1,311 @@
+#include "Kodgen/Parsing/PrecompiledHeader.h"
+
+#include <fstream>
+#include <sstream>	//std::ostringstream, std::istringstream
+#include <map>
+#include <algorithm>	//std::equal
+#include <atomic>
+
+#if _WIN32
+#include <process.h>	//_getpid
+#else
+#include <unistd.h>		//getpid
+#endif
+
+using namespace kodgen;
+
+/** Number of precompiled headers created by the process, used to give a unique name to their files. */
+static std::atomic<uint64> precompiledHeaderCount = 0u;
+
+/**
+*	@brief Remove the leading and trailing whitespaces of a string.
+*
+*	@param str The string to trim.
+*
+*	@return The trimmed string.
+*/
+static std::string trim(std::string const& str) noexcept
+{
+	size_t begin	= str.find_first_not_of(" \t\r\n");
+	size_t end		= str.find_last_not_of(" \t\r\n");
+
+	return (begin == std::string::npos) ? std::string() : str.substr(begin, end - begin + 1u);
+}
+
+PrecompiledHeader::PrecompiledHeader(std::vector<std::string> preludeIncludes, bool isForced, uint64 fingerprint) noexcept:
+	_preludeIncludes{std::move(preludeIncludes)},
+	_isForced{isForced},
+	_fingerprint{fingerprint}
+{
+	std::ostringstream fileName;
+
+	//Several processes can build precompiled headers at the same time, so files are also named after the process
+#if _WIN32
+	fileName << "KodgenPrelude_" << _getpid() << "_" << precompiledHeaderCount++;
+#else
+	fileName << "KodgenPrelude_" << getpid() << "_" << precompiledHeaderCount++;
+#endif
+
+	std::error_code	errorCode;
+	fs::path		directory = fs::temp_directory_path(errorCode);
+
+	_preludeFile	= directory / (fileName.str() + ".h");
+	_file			= directory / (fileName.str() + ".pch");
+}
+
+PrecompiledHeader::~PrecompiledHeader() noexcept
+{
+	std::error_code errorCode;
+
+	fs::remove(_file, errorCode);
+	fs::remove(_preludeFile, errorCode);
+}
+
+std::vector<std::string> PrecompiledHeader::getLeadingIncludes(fs::path const& file) noexcept
+{
+	std::ifstream stream(file);
+
+	return getLeadingIncludes(file, stream);
+}
+
+std::vector<std::string> PrecompiledHeader::getLeadingIncludes(fs::path const& file, std::istream& stream) noexcept
+{
+	std::vector<std::string>	result;
+	std::string					line;
+	std::string					includeGuard;
+	bool						isInBlockComment	= false;
+	bool						isGuardDefined		= false;
+
+	while (std::getline(stream, line))
+	{
+		//Strip comments, a block comment followed by code on the same line ends the prelude like any other code
+		if (isInBlockComment)
+		{
+			size_t commentEnd = line.find("*/");
+
+			if (commentEnd == std::string::npos)
+			{
+				continue;
+			}
+
+			line				= line.substr(commentEnd + 2u);
+			isInBlockComment	= false;
+		}
+
+		line = trim(line);
+
+		while (line.compare(0u, 2u, "/*") == 0)
+		{
+			size_t commentEnd = line.find("*/", 2u);
+
+			if (commentEnd == std::string::npos)
+			{
+				isInBlockComment = true;
+				line.clear();
+			}
+			else
+			{
+				line = trim(line.substr(commentEnd + 2u));
+			}
+		}
+
+		if (line.empty() || line.compare(0u, 2u, "//") == 0)
+		{
+			continue;
+		}
+
+		if (line[0] != '#')
+		{
+			break;
+		}
+
+		std::istringstream	directiveStream(line.substr(1u));
+		std::string			directive;
+		std::string			operand;
+
+		directiveStream >> directive;
+
+		if (directive == "include")
+		{
+			std::getline(directiveStream, operand);
+			operand = trim(operand);
+
+			char	closingDelimiter	= (!operand.empty() && operand[0] == '<') ? '>' : '"';
+			size_t	operandEnd			= operand.find(closingDelimiter, 1u);
+
+			if (operand.empty() || (operand[0] != '<' && operand[0] != '"') || operandEnd == std::string::npos)
+			{
+				break;
+			}
+
+			operand.resize(operandEnd + 1u);
+
+			//A quoted include is first searched next to the including file
+			if (operand[0] == '"')
+			{
+				std::error_code	errorCode;
+				fs::path		localPath = file.parent_path() / operand.substr(1u, operand.size() - 2u);
+
+				if (fs::is_regular_file(localPath, errorCode))
+				{
+					operand = "\"" + FilesystemHelpers::normalizeSeparator(FilesystemHelpers::sanitizePath(localPath)).string() + "\"";
+				}
+			}
+
+			result.emplace_back(std::move(operand));
+		}
+		else if (directive == "pragma")
+		{
+			directiveStream >> operand;
+
+			if (operand != "once")
+			{
+				break;
+			}
+		}
+		else if (directive == "ifndef" && includeGuard.empty() && result.empty())
+		{
+			directiveStream >> includeGuard;
+		}
+		else if (directive == "define" && !includeGuard.empty() && !isGuardDefined)
+		{
+			directiveStream >> operand;
+
+			if (operand != includeGuard)
+			{
+				break;
+			}
+
+			isGuardDefined = true;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	return result;
+}
+
+std::vector<std::string> PrecompiledHeader::findCommonIncludePrefix(std::vector<fs::path> const& files) noexcept
+{
+	//Count the files starting with each include prefix
+	std::map<std::vector<std::string>, size_t> prefixFileCounts;
+
+	for (fs::path const& file : files)
+	{
+		std::vector<std::string> includes = getLeadingIncludes(file);
+
+		while (!includes.empty())
+		{
+			prefixFileCounts[includes]++;
+			includes.pop_back();
+		}
+	}
+
+	std::vector<std::string>	result;
+	size_t						bestScore = 0u;
+
+	for (auto const& [prefix, fileCount] : prefixFileCounts)
+	{
+		size_t score = prefix.size() * fileCount;
+
+		//Precompiling a prefix used by a single file doesn't save anything
+		if (fileCount >= 2u && (score > bestScore || (score == bestScore && prefix.size() > result.size())))
+		{
+			result		= prefix;
+			bestScore	= score;
+		}
+	}
+
+	return result;
+}
+
+bool PrecompiledHeader::writePrelude() const noexcept
+{
+	std::ofstream stream(_preludeFile, std::ios::out | std::ios::trunc);
+
+	for (std::string const& include : _preludeIncludes)
+	{
+		stream << "#include " << include << "\n";
+	}
+
+	return stream.good();
+}
+
+void PrecompiledHeader::onBuilt(std::vector<fs::path>&& includedFiles) noexcept
+{
+	std::error_code errorCode;
+
+	_includedFiles	= std::move(includedFiles);
+	_buildTime		= fs::last_write_time(_file, errorCode);
+}
+
+bool PrecompiledHeader::appliesTo(fs::path const& file) const noexcept
+{
+	return _isForced || appliesTo(getLeadingIncludes(file));
+}
+
+bool PrecompiledHeader::appliesTo(fs::path const& file, std::string const& content) const noexcept
+{
+	if (_isForced)
+	{
+		return true;
+	}
+
+	std::istringstream stream(content);
+
+	return appliesTo(getLeadingIncludes(file, stream));
+}
+
+bool PrecompiledHeader::appliesTo(std::vector<std::string> const& includes) const noexcept
+{
+	return includes.size() >= _preludeIncludes.size() && std::equal(_preludeIncludes.cbegin(), _preludeIncludes.cend(), includes.cbegin());
+}
+
+bool PrecompiledHeader::isUpToDate() const noexcept
+{
+	std::error_code errorCode;
+
+	for (fs::path const& includedFile : _includedFiles)
+	{
+		fs::file_time_type lastWriteTime = fs::last_write_time(includedFile, errorCode);
+
+		if (errorCode || lastWriteTime > _buildTime)
+		{
+			return false;
+		}
+	}
+
+	return fs::exists(_file, errorCode);
+}
+
+std::vector<std::string> const& PrecompiledHeader::getPreludeIncludes() const noexcept
+{
+	return _preludeIncludes;
+}
+
+bool PrecompiledHeader::isForced() const noexcept
+{
+	return _isForced;
+}
+
+uint64 PrecompiledHeader::getFingerprint() const noexcept
+{
+	return _fingerprint;
+}
+
+fs::path const& PrecompiledHeader::getPreludeFile() const noexcept
+{
+	return _preludeFile;
+}
+
+fs::path const& PrecompiledHeader::getFile() const noexcept
+{
+	return _file;
+}
+
+std::vector<fs::path> const& PrecompiledHeader::getIncludedFiles() const noexcept
+{
+	return _includedFiles;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "Kodgen/Parsing/TranslationUnitCache.h"
+
+#include <iterator>	//std::prev
+
+using namespace kodgen;
+
+TranslationUnitCache::~TranslationUnitCache() noexcept
+{
+	clear();
+}
+
+uint64 TranslationUnitCache::computeMemoryUsage(CXTranslationUnit translationUnit) noexcept
+{
+	CXTUResourceUsage	resourceUsage	= clang_getCXTUResourceUsage(translationUnit);
+	uint64				result			= 0u;
+
+	for (unsigned int i = 0u; i < resourceUsage.numEntries; i++)
+	{
+		result += resourceUsage.entries[i].amount;
+	}
+
+	clang_disposeCXTUResourceUsage(resourceUsage);
+
+	return result;
+}
+
+CXTranslationUnit TranslationUnitCache::acquire(fs::path const& file, uint64 argumentsFingerprint, std::shared_ptr<void>& out_clangIndex) noexcept
+{
+	std::unique_lock lock(_mutex);
+
+	auto indexIt = _entryIndices.find(file);
+
+	if (indexIt == _entryIndices.end())
+	{
+		return nullptr;
+	}
+
+	Entry entry = std::move(*indexIt->second);
+
+	_entries.erase(indexIt->second);
+	_entryIndices.erase(indexIt);
+	_memoryUsage -= entry.memoryUsage;
+
+	lock.unlock();
+
+	//A translation unit can't be reparsed with other compilation arguments
+	if (entry.argumentsFingerprint != argumentsFingerprint)
+	{
+		clang_disposeTranslationUnit(entry.translationUnit);
+
+		return nullptr;
+	}
+
+	out_clangIndex = std::move(entry.clangIndex);
+
+	return entry.translationUnit;
+}
+
+void TranslationUnitCache::release(fs::path const& file, CXTranslationUnit translationUnit, std::shared_ptr<void> clangIndex, uint64 argumentsFingerprint, uint64 memoryLimit) noexcept
+{
+	Entry entry;
+
+	entry.file					= file;
+	entry.translationUnit		= translationUnit;
+	entry.clangIndex			= std::move(clangIndex);
+	entry.argumentsFingerprint	= argumentsFingerprint;
+	entry.memoryUsage			= computeMemoryUsage(translationUnit);
+
+	std::list<Entry> evictedEntries;
+
+	{
+		std::lock_guard lock(_mutex);
+
+		auto [indexIt, isInserted] = _entryIndices.try_emplace(file);
+
+		//Several threads parsing the same file each release their own translation unit, only the last one is kept
+		if (!isInserted)
+		{
+			_memoryUsage -= indexIt->second->memoryUsage;
+			evictedEntries.splice(evictedEntries.end(), _entries, indexIt->second);
+		}
+
+		_memoryUsage += entry.memoryUsage;
+		_entries.emplace_front(std::move(entry));
+		indexIt->second = _entries.begin();
+
+		//The released translation unit is evicted as well if it exceeds the limit on its own
+		while (_memoryUsage > memoryLimit)
+		{
+			_memoryUsage -= _entries.back().memoryUsage;
+			_entryIndices.erase(_entries.back().file);
+			evictedEntries.splice(evictedEntries.end(), _entries, std::prev(_entries.end()));
+		}
+	}
+
+	//Dispose translation units outside of the lock since it can take a while
+	for (Entry const& evictedEntry : evictedEntries)
+	{
+		clang_disposeTranslationUnit(evictedEntry.translationUnit);
+	}
+}
+
+void TranslationUnitCache::clear() noexcept
+{
+	std::list<Entry> entries;
+
+	{
+		std::lock_guard lock(_mutex);
+
+		entries.swap(_entries);
+		_entryIndices.clear();
+		_memoryUsage = 0u;
+	}
+
+	for (Entry const& entry : entries)
+	{
+		clang_disposeTranslationUnit(entry.translationUnit);
+	}
+}
\ No newline at end of file
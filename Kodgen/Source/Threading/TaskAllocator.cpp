@@ -0,0 +1,178 @@
+#include "Kodgen/Threading/TaskAllocator.h"
+
+#include <mutex>
+#include <vector>
+
+using namespace kodgen;
+
+/** Size classes are multiples of this size, so that all blocks keep the chunk alignment. */
+static constexpr std::size_t	blockGranularity	= 64u;
+
+/** Number of size classes. Bigger blocks are not pooled. */
+static constexpr std::size_t	sizeClassCount		= 16u;
+
+/** Number of blocks exchanged at once between a thread and the shared cache, which is also the number of blocks of a chunk. */
+static constexpr std::size_t	batchSize			= 64u;
+
+struct TaskBlockPool::FreeBlock
+{
+	/** Next free block of the list. */
+	FreeBlock*	next;
+
+	/** Next batch of the shared cache, only used by the first block of a batch. */
+	FreeBlock*	nextBatch;
+
+	/** Number of blocks of the batch, only used by the first block of a batch. */
+	std::size_t	blockCount;
+};
+
+struct TaskBlockPool::ThreadCache
+{
+	/** Free blocks of each size class. */
+	FreeBlock*	freeBlocks[sizeClassCount]		= {};
+
+	/** Number of free blocks of each size class. */
+	std::size_t	freeBlockCounts[sizeClassCount]	= {};
+
+	/**
+	*	Give the free blocks back to the shared cache when the thread exits.
+	*/
+	~ThreadCache() noexcept;
+};
+
+struct TaskBlockPool::SharedCache
+{
+	/** Mutex protecting the batches and the chunks. */
+	std::mutex			mutex;
+
+	/** Batches of free blocks of each size class, linked through their first block. */
+	FreeBlock*			batches[sizeClassCount]	= {};
+
+	/** Chunks allocated for the blocks. */
+	std::vector<void*>	chunks;
+};
+
+thread_local TaskBlockPool::ThreadCache TaskBlockPool::_threadCache;
+
+TaskBlockPool::ThreadCache::~ThreadCache() noexcept
+{
+	SharedCache& sharedCache = getSharedCache();
+
+	std::lock_guard lock(sharedCache.mutex);
+
+	for (std::size_t sizeClass = 0u; sizeClass < sizeClassCount; sizeClass++)
+	{
+		if (freeBlocks[sizeClass] != nullptr)
+		{
+			freeBlocks[sizeClass]->blockCount	= freeBlockCounts[sizeClass];
+			freeBlocks[sizeClass]->nextBatch	= sharedCache.batches[sizeClass];
+			sharedCache.batches[sizeClass]		= freeBlocks[sizeClass];
+		}
+
+		//Tasks released afterwards by static objects destructors start from an empty cache again
+		freeBlocks[sizeClass]		= nullptr;
+		freeBlockCounts[sizeClass]	= 0u;
+	}
+}
+
+TaskBlockPool::SharedCache& TaskBlockPool::getSharedCache() noexcept
+{
+	//Intentionally leaked: thread pools with static storage duration might be constructed before the first task allocation,
+	//so they would be destroyed after the cache and release their tasks into a destroyed cache
+	static SharedCache* sharedCache = new SharedCache();
+
+	return *sharedCache;
+}
+
+void TaskBlockPool::refill(std::size_t sizeClass) noexcept
+{
+	SharedCache& sharedCache = getSharedCache();
+
+	std::lock_guard lock(sharedCache.mutex);
+
+	FreeBlock* batch = sharedCache.batches[sizeClass];
+
+	if (batch != nullptr)
+	{
+		sharedCache.batches[sizeClass]				= batch->nextBatch;
+		_threadCache.freeBlocks[sizeClass]			= batch;
+		_threadCache.freeBlockCounts[sizeClass]		= batch->blockCount;
+	}
+	else
+	{
+		std::size_t const	blockSize	= (sizeClass + 1u) * blockGranularity;
+		char*				chunk		= static_cast<char*>(::operator new(blockSize * batchSize));
+
+		sharedCache.chunks.push_back(chunk);
+
+		//Link the blocks of the new chunk in address order
+		for (std::size_t i = 0u; i < batchSize; i++)
+		{
+			reinterpret_cast<FreeBlock*>(chunk + i * blockSize)->next = (i + 1u < batchSize) ? reinterpret_cast<FreeBlock*>(chunk + (i + 1u) * blockSize) : nullptr;
+		}
+
+		_threadCache.freeBlocks[sizeClass]		= reinterpret_cast<FreeBlock*>(chunk);
+		_threadCache.freeBlockCounts[sizeClass]	= batchSize;
+	}
+}
+
+void* TaskBlockPool::allocate(std::size_t size) noexcept
+{
+	std::size_t const sizeClass = (size == 0u) ? 0u : (size - 1u) / blockGranularity;
+
+	if (sizeClass >= sizeClassCount)
+	{
+		return ::operator new(size);
+	}
+
+	if (_threadCache.freeBlocks[sizeClass] == nullptr)
+	{
+		refill(sizeClass);
+	}
+
+	FreeBlock* block = _threadCache.freeBlocks[sizeClass];
+
+	_threadCache.freeBlocks[sizeClass] = block->next;
+	_threadCache.freeBlockCounts[sizeClass]--;
+
+	return block;
+}
+
+void TaskBlockPool::deallocate(void* block, std::size_t size) noexcept
+{
+	std::size_t const sizeClass = (size == 0u) ? 0u : (size - 1u) / blockGranularity;
+
+	if (sizeClass >= sizeClassCount)
+	{
+		::operator delete(block);
+		return;
+	}
+
+	FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+
+	freeBlock->next							= _threadCache.freeBlocks[sizeClass];
+	_threadCache.freeBlocks[sizeClass]		= freeBlock;
+
+	//Threads releasing more tasks than they allocate give a batch back, keeping one batch to avoid exchanging a batch back and forth
+	if (++_threadCache.freeBlockCounts[sizeClass] == 2u * batchSize)
+	{
+		FreeBlock* lastBlock = freeBlock;
+
+		for (std::size_t i = 1u; i < batchSize; i++)
+		{
+			lastBlock = lastBlock->next;
+		}
+
+		_threadCache.freeBlocks[sizeClass]		= lastBlock->next;
+		_threadCache.freeBlockCounts[sizeClass]	-= batchSize;
+		lastBlock->next							= nullptr;
+		freeBlock->blockCount					= batchSize;
+
+		SharedCache& sharedCache = getSharedCache();
+
+		std::lock_guard lock(sharedCache.mutex);
+
+		freeBlock->nextBatch			= sharedCache.batches[sizeClass];
+		sharedCache.batches[sizeClass]	= freeBlock;
+	}
+}
\ No newline at end of file
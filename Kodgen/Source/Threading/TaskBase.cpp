@@ -3,12 +3,59 @@
 using namespace kodgen;
 
 TaskBase::TaskBase(char const* name, std::vector<std::shared_ptr<TaskBase>>&& deps) noexcept:
-	_name{name},
+	_name{(name != nullptr) ? name : ""},
 	dependencies{std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps)}
 {
 }
 
-std::string const& TaskBase::getName() const noexcept
+char const* TaskBase::getName() const noexcept
 {
 	return _name;
+}
+
+ETaskPriority TaskBase::getPriority() const noexcept
+{
+	return _priority;
+}
+
+void TaskBase::addDependency(std::shared_ptr<TaskBase> dependency) noexcept
+{
+	dependencies.emplace_back(std::move(dependency));
+}
+
+bool TaskBase::addSuccessor(std::shared_ptr<TaskBase> const& successor) noexcept
+{
+	std::lock_guard lock(_successorsMutex);
+
+	if (_isCompleted)
+	{
+		return false;
+	}
+
+	_successors.push_back(successor);
+
+	return true;
+}
+
+std::vector<std::shared_ptr<TaskBase>> TaskBase::complete() noexcept
+{
+	std::vector<std::shared_ptr<TaskBase>> successors;
+
+	{
+		std::lock_guard lock(_successorsMutex);
+
+		_isCompleted	= true;
+		successors		= std::move(_successors);
+	}
+
+	_completionCondition.notify_all();
+
+	return successors;
+}
+
+void TaskBase::waitForCompletion() noexcept
+{
+	std::unique_lock lock(_successorsMutex);
+
+	_completionCondition.wait(lock, [this]() { return _isCompleted; });
 }
\ No newline at end of file
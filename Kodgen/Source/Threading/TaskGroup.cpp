@@ -0,0 +1,62 @@
+#include "Kodgen/Threading/TaskGroup.h"
+
+#include <thread>	//std::this_thread::yield
+
+using namespace kodgen;
+
+TaskGroup::TaskGroup(ThreadPool& threadPool) noexcept:
+	_threadPool{threadPool}
+{
+}
+
+TaskGroup::~TaskGroup() noexcept
+{
+	wait();
+}
+
+void TaskGroup::submitTasks(std::vector<std::shared_ptr<TaskBase>> const& tasks) noexcept
+{
+	//Count the tasks before they are submitted so that the group never sees them complete before they are counted
+	for (std::shared_ptr<TaskBase> const& task : tasks)
+	{
+		task->_group = this;
+	}
+
+	_pendingTaskCount.fetch_add(tasks.size());
+
+	_threadPool.submitTasks(tasks);
+}
+
+void TaskGroup::onTaskCompleted() noexcept
+{
+	std::lock_guard lock(_mutex);
+
+	if (_pendingTaskCount.fetch_sub(1u) == 1u)
+	{
+		_condition.notify_all();
+	}
+}
+
+void TaskGroup::wait() noexcept
+{
+	while (_pendingTaskCount != 0u && _threadPool.runQueuedTask())
+	{
+	}
+
+	//A worker sleeping here could leave queued tasks of the group without any worker to run them
+	if (ThreadPool::_currentWorkerPool == &_threadPool)
+	{
+		while (_pendingTaskCount != 0u)
+		{
+			if (!_threadPool.runQueuedTask())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	//Synchronize with the completion of the last task even if the group already completed, so that the group can be destroyed right after
+	std::unique_lock lock(_mutex);
+
+	_condition.wait(lock, [this]() { return _pendingTaskCount == 0u; });
+}
\ No newline at end of file
@@ -1,34 +1,53 @@
 #include "Kodgen/Threading/ThreadPool.h"
+#include "Kodgen/Threading/TaskGroup.h"
 
 #include <cassert>
+#include <algorithm>	//std::max, std::min
 
 using namespace kodgen;
 
-ThreadPool::ThreadPool(uint32 threadCount, ETerminationMode	terminationMode) noexcept:
-	_destructorCalled{false},
-	_workingWorkers{threadCount},
+thread_local ThreadPool*	ThreadPool::_currentWorkerPool	= nullptr;
+thread_local uint32			ThreadPool::_currentWorkerIndex	= 0u;
+
+ThreadPool::ThreadPool(uint32 threadCount, ETerminationMode	terminationMode, uint32 maxThreadCount) noexcept:
 	terminationMode{terminationMode}
 {
-	assert(threadCount > 0u);
+	//A pool without worker still has a queue for the threads running its tasks
+	uint32 const maxWorkerCount = std::max({ threadCount, maxThreadCount, 1u });
+
+	_workers.resize(maxWorkerCount);
+	_isWorkerAlive.resize(maxWorkerCount, false);
 
-	//Preallocate enough space to avoid reallocations
-	_workers.reserve(threadCount);
+	//All queues must exist before any worker starts stealing, and they are never reallocated so that workers can be added at any time
+	_workerQueues.reserve(maxWorkerCount);
 
-	for (uint32 i = 0u; i < threadCount; i++)
+	for (uint32 i = 0u; i < maxWorkerCount; i++)
 	{
-		_workers.emplace_back(std::thread(std::bind(&ThreadPool::workerRoutine, this)));
+		_workerQueues.emplace_back(std::make_unique<WorkerQueue>());
 	}
+
+	_workerCounters = std::make_unique<WorkerCounters[]>(maxWorkerCount + 1u);
+
+	setWorkerCount(threadCount);
 }
 
 ThreadPool::~ThreadPool() noexcept
 {
 	_taskMutex.lock();
 	_destructorCalled = true;
+
+	//Queued tasks must be able to run to be finished
+	_isRunning = true;
 	_taskMutex.unlock();
 
 	//Awake threads so that they can perform necessary tests to exit their routine
 	_taskCondition.notify_all();
 
+	//Wait for a worker being spawned, if any, so that _workers doesn't change anymore
+	{
+		std::lock_guard lock(_workersMutex);
+	}
+
 	//Explicitely join all threads to terminate
 	for (std::thread& worker : _workers)
 	{
@@ -37,97 +56,551 @@ ThreadPool::~ThreadPool() noexcept
 			worker.join();
 		}
 	}
+
+	//Without worker, the destroying thread finishes the queued tasks itself
+	while (terminationMode == ETerminationMode::FinishAll && runQueuedTask())
+	{
+	}
+
+	//Discard the tasks which were not run. Their successors reference them as dependencies, so break the references cycles.
+	std::vector<std::shared_ptr<TaskBase>>	discardedTasks;
+	TaskBase*								injectedTask = _injectedTasks.exchange(nullptr);
+
+	while (injectedTask != nullptr)
+	{
+		TaskBase* next = injectedTask->_nextInjectedTask;
+
+		discardedTasks.emplace_back(std::move(injectedTask->_injectedReference));
+
+		injectedTask = next;
+	}
+
+	for (std::unique_ptr<WorkerQueue>& queue : _workerQueues)
+	{
+		for (std::deque<std::shared_ptr<TaskBase>>& tasks : queue->tasks)
+		{
+			discardedTasks.insert(discardedTasks.cend(), std::make_move_iterator(tasks.begin()), std::make_move_iterator(tasks.end()));
+		}
+	}
+
+	while (!discardedTasks.empty())
+	{
+		std::vector<std::shared_ptr<TaskBase>> successors = discardedTasks.back()->complete();
+
+		discardedTasks.pop_back();
+		discardedTasks.insert(discardedTasks.cend(), std::make_move_iterator(successors.begin()), std::make_move_iterator(successors.end()));
+	}
 }
 
-void ThreadPool::workerRoutine() noexcept
+void ThreadPool::workerRoutine(uint32 workerIndex) noexcept
 {
-	std::unique_lock lock(_taskMutex);
+	_currentWorkerPool	= this;
+	_currentWorkerIndex	= workerIndex;
+
+	std::unique_lock lock(_taskMutex, std::defer_lock);
 
-	while (shouldKeepRunning())
+	while (true)
 	{
-		if (!_tasks.empty() && _isRunning)
+		//Workers removed by setWorkerCount exit without taking any new task
+		bool mustExit = workerIndex >= _targetWorkerCount;
+
+		if (!mustExit)
 		{
-			//We own the mutex before grabbing a task
-			std::shared_ptr<TaskBase> task = getTask();
+			_searchingWorkers.fetch_add(1u);
+
+			std::shared_ptr<TaskBase> task = _isRunning ? getTask(workerIndex) : nullptr;
+
+			_searchingWorkers.fetch_sub(1u);
 
 			if (task != nullptr)
 			{
-				//Release the mutex before executing the task to allow other workers to grab tasks during execution
-				lock.unlock();
+				//Wake workers up one by one while there are tasks left, instead of waking a worker for each submitted task
+				wakeWorker();
 
-				task->execute();
+				executeTask(*task);
 
-				lock.lock();
+				continue;
 			}
+
+			mustExit = _destructorCalled && (terminationMode == ETerminationMode::FinishCurrent || _queuedTaskCount == 0u);
+		}
+
+		lock.lock();
+
+		//A worker is about to sleep or exit, decrement working workers count.
+		//pushTask increments the queued task count before checking the working workers count, so either the predicate sees the new task or the worker is notified.
+		if (_workingWorkers.fetch_sub(1u) == 1u)
+		{
+			_joinCondition.notify_all();
 		}
 
-		if (!_destructorCalled && (_tasks.empty() || !_isRunning))
+		if (mustExit || !waitForTasks(lock, workerIndex))
 		{
-			//A worker is about to sleep, decrement working workers count
-			_workingWorkers.fetch_sub(1u);
+			break;
+		}
+
+		//A worker is resuming its activity, increment working workers count
+		_workingWorkers.fetch_add(1u);
+
+		lock.unlock();
+	}
 
+	//The live workers count is updated with the task mutex locked, so that wakeWorker never notifies a worker which is exiting
+	_liveWorkerCount.fetch_sub(1u);
+
+	{
+		std::lock_guard workersLock(_workersMutex);
+
+		_isWorkerAlive[workerIndex] = false;
+	}
+
+	lock.unlock();
+
+	//Tasks left in the queue of the exiting worker must be run by another worker
+	wakeWorker();
+
+	_currentWorkerPool = nullptr;
+}
+
+bool ThreadPool::waitForTasks(std::unique_lock<std::mutex>& lock, uint32 workerIndex) noexcept
+{
+	auto canResume = [this, workerIndex]()
+	{
+		return _destructorCalled || workerIndex >= _targetWorkerCount || (_isRunning && _queuedTaskCount != 0u);
+	};
+
+	std::chrono::steady_clock::time_point const	sleepStart	= std::chrono::steady_clock::now();
+	bool										hasTask		= true;
+
+	while (!canResume())
+	{
+		//The idle timeout is read after each wake up since setIdleTimeout notifies the sleeping workers
+		if (_idleTimeout.count() == 0)
+		{
 			_taskCondition.wait(lock);
+		}
+		else if (_taskCondition.wait_until(lock, sleepStart + _idleTimeout) == std::cv_status::timeout && !canResume())
+		{
+			hasTask = false;
+			break;
+		}
+	}
 
-			//A worker is resuming its activity, increment working workers count
-			_workingWorkers.fetch_add(1u);
+	if (_isCollectingStatistics.load(std::memory_order_relaxed))
+	{
+		_workerCounters[workerIndex].idleDuration.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - sleepStart).count(),
+															std::memory_order_relaxed);
+	}
+
+	return hasTask;
+}
+
+void ThreadPool::spawnWorkers() noexcept
+{
+	//Threads of the workers which exited are joined once the mutex is released, since exiting workers lock it
+	std::vector<std::thread> exitedWorkers;
+
+	{
+		std::lock_guard lock(_workersMutex);
+
+		if (_destructorCalled)
+		{
+			return;
+		}
+
+		for (uint32 i = 0u; i < _targetWorkerCount && _liveWorkerCount < _targetWorkerCount; i++)
+		{
+			//An exiting worker can spawn workers, but not in place of itself since it can't join its own thread
+			if (!_isWorkerAlive[i] && (_currentWorkerPool != this || _currentWorkerIndex != i))
+			{
+				if (_workers[i].joinable())
+				{
+					exitedWorkers.emplace_back(std::move(_workers[i]));
+				}
+
+				_isWorkerAlive[i] = true;
+
+				//A new worker looks for tasks before sleeping, so it is counted as working
+				_workingWorkers.fetch_add(1u);
+				_liveWorkerCount.fetch_add(1u);
+
+				_workers[i] = std::thread(std::bind(&ThreadPool::workerRoutine, this, i));
+			}
 		}
 	}
+
+	for (std::thread& exitedWorker : exitedWorkers)
+	{
+		exitedWorker.join();
+	}
 }
 
-std::shared_ptr<TaskBase> ThreadPool::getTask() noexcept
+std::shared_ptr<TaskBase> ThreadPool::getTask(uint32 workerIndex) noexcept
 {
-	//Iterate over all tasks
-	for (decltype(_tasks)::iterator it = _tasks.begin(); it != _tasks.end(); it++)
+	if (_queuedTaskCount == 0u)
 	{
-		//Get the first ready task
-		if ((*it)->isReadyToExecute())
+		return nullptr;
+	}
+
+	WorkerQueue&				ownQueue	= *_workerQueues[workerIndex];
+	std::shared_ptr<TaskBase>	task;
+
+	//Look for the highest priority first. Injected tasks are counted before they are sorted in the queues, so they are taken whatever the priority.
+	for (size_t priority = _priorityCount; task == nullptr && priority-- != 0u;)
+	{
+		if (_queuedTaskCounts[priority] == 0u)
 		{
-			std::shared_ptr<TaskBase> result = std::move(*it);
+			continue;
+		}
+
+		task = popTask(ownQueue, priority);
 
-			_tasks.erase(it);
+		if (task == nullptr && _injectedTasks.load() != nullptr)
+		{
+			takeInjectedTasks(ownQueue);
 
-			return result;
+			task = popTask(ownQueue, priority);
+		}
+
+		//Steal from the next workers first so that thieves spread over the queues
+		for (size_t i = 1u; task == nullptr && i < _workerQueues.size(); i++)
+		{
+			task = popTask(*_workerQueues[(workerIndex + i) % _workerQueues.size()], priority);
+
+			if (task != nullptr && _isCollectingStatistics.load(std::memory_order_relaxed))
+			{
+				getCurrentCounters().stolenTaskCount.fetch_add(1u, std::memory_order_relaxed);
+			}
 		}
 	}
 
-	return nullptr;
+	return task;
 }
 
-void ThreadPool::joinWorkers() noexcept
+std::shared_ptr<TaskBase> ThreadPool::popTask(WorkerQueue& queue, size_t priority) noexcept
 {
-	std::unique_lock lock(_taskMutex);
+	if (queue.sizes[priority] == 0u)
+	{
+		return nullptr;
+	}
+
+	std::unique_lock lock(queue.mutex, std::defer_lock);
 
-	if (_destructorCalled)
+	if (!_isCollectingStatistics.load(std::memory_order_relaxed))
 	{
-		lock.unlock();
+		lock.lock();
+	}
+	else if (!lock.try_lock())
+	{
+		getCurrentCounters().contendedLockCount.fetch_add(1u, std::memory_order_relaxed);
 
-		//Awake threads so that they can perform necessary tests to exit their routine
-		_taskCondition.notify_all();
+		lock.lock();
+	}
 
-		//Explicitely join all threads to terminate
-		for (std::thread& worker : _workers)
+	std::deque<std::shared_ptr<TaskBase>>& tasks = queue.tasks[priority];
+
+	//The queue might have been emptied by another worker since its size has been checked
+	if (tasks.empty())
+	{
+		return nullptr;
+	}
+
+	std::shared_ptr<TaskBase> result = std::move(tasks.front());
+
+	tasks.pop_front();
+	queue.sizes[priority].fetch_sub(1u);
+	_queuedTaskCounts[priority].fetch_sub(1u);
+	_queuedTaskCount.fetch_sub(1u);
+
+	return result;
+}
+
+void ThreadPool::takeInjectedTasks(WorkerQueue& queue) noexcept
+{
+	//Take all injected tasks at once, so that concurrent pushes never see a node being removed
+	appendTaskChain(queue, _injectedTasks.exchange(nullptr));
+}
+
+void ThreadPool::appendTaskChain(WorkerQueue& queue, TaskBase* lastTask) noexcept
+{
+	//The chain is a stack, reverse it to retrieve the submission order
+	TaskBase* firstTask = nullptr;
+
+	while (lastTask != nullptr)
+	{
+		TaskBase* next = lastTask->_nextInjectedTask;
+
+		lastTask->_nextInjectedTask	= firstTask;
+		firstTask					= lastTask;
+		lastTask					= next;
+	}
+
+	std::lock_guard lock(queue.mutex);
+
+	while (firstTask != nullptr)
+	{
+		TaskBase* next = firstTask->_nextInjectedTask;
+
+		size_t priority = static_cast<size_t>(firstTask->_priority);
+
+		firstTask->_nextInjectedTask = nullptr;
+		queue.tasks[priority].emplace_back(std::move(firstTask->_injectedReference));
+		queue.sizes[priority].fetch_add(1u);
+
+		firstTask = next;
+	}
+}
+
+bool ThreadPool::registerTask(std::shared_ptr<TaskBase> const& task) noexcept
+{
+	//Hold an extra pending dependency during the registration so that a dependency completing meanwhile doesn't queue the task
+	task->_pendingDependencyCount = 1u;
+
+	for (std::shared_ptr<TaskBase> const& dependency : task->dependencies)
+	{
+		task->_pendingDependencyCount.fetch_add(1u);
+
+		if (!dependency->addSuccessor(task))
 		{
-			if (worker.joinable())
+			task->_pendingDependencyCount.fetch_sub(1u);
+		}
+	}
+
+	return task->_pendingDependencyCount.fetch_sub(1u) == 1u;
+}
+
+void ThreadPool::addTask(std::shared_ptr<TaskBase> task) noexcept
+{
+	if (registerTask(task))
+	{
+		pushTask(std::move(task), false);
+	}
+}
+
+void ThreadPool::submitTasks(std::vector<std::shared_ptr<TaskBase>> const& tasks) noexcept
+{
+	//Chain the ready tasks like the injection queue, so that they are queued at once once they are all registered
+	TaskBase*									firstReadyTask			= nullptr;
+	TaskBase*									lastReadyTask			= nullptr;
+	size_t										readyTaskCount			= 0u;
+	std::array<size_t, _priorityCount>			readyTaskCounts			= {};
+	bool const									isCollectingStatistics	= _isCollectingStatistics.load(std::memory_order_relaxed);
+	std::chrono::steady_clock::time_point const	readyTime				= isCollectingStatistics ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+	for (std::shared_ptr<TaskBase> const& task : tasks)
+	{
+		if (registerTask(task))
+		{
+			task->_readyTime			= readyTime;
+			task->_injectedReference	= task;
+			task->_nextInjectedTask		= lastReadyTask;
+			lastReadyTask				= task.get();
+
+			if (firstReadyTask == nullptr)
 			{
-				worker.join();
+				firstReadyTask = lastReadyTask;
 			}
+
+			readyTaskCount++;
+			readyTaskCounts[static_cast<size_t>(task->_priority)]++;
+		}
+	}
+
+	if (readyTaskCount == 0u)
+	{
+		return;
+	}
+
+	if (_currentWorkerPool == this)
+	{
+		appendTaskChain(*_workerQueues[_currentWorkerIndex], lastReadyTask);
+	}
+	else
+	{
+		//Splice the whole chain on top of the injection queue
+		firstReadyTask->_nextInjectedTask = _injectedTasks.load();
+
+		while (!_injectedTasks.compare_exchange_weak(firstReadyTask->_nextInjectedTask, lastReadyTask))
+		{
+		}
+	}
+
+	for (size_t priority = 0u; priority < _priorityCount; priority++)
+	{
+		_queuedTaskCounts[priority].fetch_add(readyTaskCounts[priority]);
+	}
+
+	size_t const queuedTaskCount = _queuedTaskCount.fetch_add(readyTaskCount) + readyTaskCount;
+
+	if (isCollectingStatistics)
+	{
+		updateMaxQueuedTaskCount(queuedTaskCount);
+	}
+
+	wakeWorker();
+}
+
+void ThreadPool::executeTask(TaskBase& task) noexcept
+{
+	bool const								isCollectingStatistics	= _isCollectingStatistics.load(std::memory_order_relaxed);
+	std::chrono::steady_clock::time_point	start;
+
+	if (isCollectingStatistics)
+	{
+		start = std::chrono::steady_clock::now();
+
+		//Tasks which became ready while statistics were not collected don't have a ready time
+		if (task._readyTime != std::chrono::steady_clock::time_point())
+		{
+			getCurrentCounters().taskWaitDuration.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(start - task._readyTime).count(), std::memory_order_relaxed);
+		}
+	}
+
+	task.execute();
+
+	for (std::shared_ptr<TaskBase>& successor : task.complete())
+	{
+		//The last completed dependency queues the successor
+		if (successor->_pendingDependencyCount.fetch_sub(1u) == 1u)
+		{
+			pushTask(std::move(successor), true);
+		}
+	}
+
+	if (isCollectingStatistics)
+	{
+		WorkerCounters& counters = getCurrentCounters();
+
+		counters.busyDuration.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+		counters.executedTaskCount.fetch_add(1u, std::memory_order_relaxed);
+	}
+
+	//Notify the group last, since it might be destroyed as soon as its last task completed
+	if (task._group != nullptr)
+	{
+		task._group->onTaskCompleted();
+	}
+}
+
+bool ThreadPool::runQueuedTask() noexcept
+{
+	std::shared_ptr<TaskBase> task = _isRunning ? getTask((_currentWorkerPool == this) ? _currentWorkerIndex : 0u) : nullptr;
+
+	if (task == nullptr)
+	{
+		return false;
+	}
+
+	wakeWorker();
+
+	executeTask(*task);
+
+	return true;
+}
+
+void ThreadPool::pushTask(std::shared_ptr<TaskBase> task, bool isSuccessor) noexcept
+{
+	size_t priority = static_cast<size_t>(task->_priority);
+
+	bool const isCollectingStatistics = _isCollectingStatistics.load(std::memory_order_relaxed);
+
+	if (isCollectingStatistics)
+	{
+		task->_readyTime = std::chrono::steady_clock::now();
+	}
+
+	if (_currentWorkerPool == this)
+	{
+		//Tasks submitted by a worker go to its own queue.
+		//Successors are run next by the worker which made them ready, so that they reuse the results of their dependencies while they are still in cache.
+		WorkerQueue& queue = *_workerQueues[_currentWorkerIndex];
+
+		std::lock_guard lock(queue.mutex);
+
+		if (isSuccessor)
+		{
+			queue.tasks[priority].emplace_front(std::move(task));
 		}
+		else
+		{
+			queue.tasks[priority].emplace_back(std::move(task));
+		}
+
+		queue.sizes[priority].fetch_add(1u);
 	}
 	else
 	{
+		//The task references itself until a worker moves it to its queue
+		TaskBase* injectedTask = task.get();
+
+		injectedTask->_injectedReference	= std::move(task);
+		injectedTask->_nextInjectedTask		= _injectedTasks.load();
+
+		while (!_injectedTasks.compare_exchange_weak(injectedTask->_nextInjectedTask, injectedTask))
+		{
+		}
+	}
+
+	//Workers check the count of the priority once they know there are queued tasks, so it must be incremented first
+	_queuedTaskCounts[priority].fetch_add(1u);
+
+	size_t const queuedTaskCount = _queuedTaskCount.fetch_add(1u) + 1u;
+
+	if (isCollectingStatistics)
+	{
+		updateMaxQueuedTaskCount(queuedTaskCount);
+	}
+
+	wakeWorker();
+}
+
+ThreadPool::WorkerCounters& ThreadPool::getCurrentCounters() noexcept
+{
+	return _workerCounters[getCurrentWorkerIndex()];
+}
+
+void ThreadPool::updateMaxQueuedTaskCount(uint64 queuedTaskCount) noexcept
+{
+	uint64 maxQueuedTaskCount = _maxQueuedTaskCount.load(std::memory_order_relaxed);
+
+	while (queuedTaskCount > maxQueuedTaskCount && !_maxQueuedTaskCount.compare_exchange_weak(maxQueuedTaskCount, queuedTaskCount, std::memory_order_relaxed))
+	{
+	}
+}
+
+void ThreadPool::wakeWorker() noexcept
+{
+	//Workers are notified by setIsRunning when the pool is not running
+	if (_isRunning && _queuedTaskCount != 0u && _searchingWorkers == 0u && (_workingWorkers != _liveWorkerCount || _liveWorkerCount < _targetWorkerCount))
+	{
+		//Sleeping workers check the queued task count and exit with the task mutex locked, lock it to make sure a sleeping worker gets the notification
+		std::unique_lock	lock(_taskMutex);
+		bool				isAnyWorkerSleeping = _workingWorkers != _liveWorkerCount;
+
 		lock.unlock();
 
-		//Just wait for all workers to be blocked on the _taskCondition
-		while (_workingWorkers.load() != 0u || (_isRunning && !_tasks.empty()))
+		if (isAnyWorkerSleeping)
 		{
-			std::this_thread::yield();
+			_taskCondition.notify_one();
+		}
+		else
+		{
+			spawnWorkers();
 		}
 	}
 }
 
-bool ThreadPool::shouldKeepRunning() const noexcept
+void ThreadPool::joinWorkers(bool runQueuedTasks) noexcept
 {
-	return	!_destructorCalled || (terminationMode == ETerminationMode::FinishAll && _tasks.size() != 0u);
+	while ((runQueuedTasks || _targetWorkerCount == 0u) && runQueuedTask())
+	{
+	}
+
+	//Wait for all workers to be asleep with no task left to run.
+	//The last worker going to sleep notifies the joining threads, and a worker only sleeps if the pool is not running or doesn't have any queued task.
+	std::unique_lock lock(_taskMutex);
+
+	_joinCondition.wait(lock, [this]() { return _workingWorkers == 0u && (!_isRunning || _queuedTaskCount == 0u); });
 }
 
 void ThreadPool::setIsRunning(bool isRunning) noexcept
@@ -144,5 +617,149 @@ void ThreadPool::setIsRunning(bool isRunning) noexcept
 		{
 			_taskCondition.notify_all();
 		}
+		else
+		{
+			//Joining threads don't wait for the queued tasks anymore
+			_joinCondition.notify_all();
+		}
+	}
+}
+
+void ThreadPool::setWorkerCount(uint32 workerCount) noexcept
+{
+	{
+		//Sleeping workers check the worker count with the task mutex locked
+		std::lock_guard lock(_taskMutex);
+
+		_targetWorkerCount = std::min(workerCount, getMaxWorkerCount());
+	}
+
+	//Wake the removed workers up so that they exit
+	_taskCondition.notify_all();
+
+	spawnWorkers();
+}
+
+void ThreadPool::setIdleTimeout(std::chrono::milliseconds idleTimeout) noexcept
+{
+	{
+		std::lock_guard lock(_taskMutex);
+
+		_idleTimeout = idleTimeout;
+	}
+
+	//Sleeping workers apply the new timeout once they wake up
+	_taskCondition.notify_all();
+}
+
+void ThreadPool::stopWorkers() noexcept
+{
+	uint32 const workerCount = _targetWorkerCount;
+
+	//Without target, the workers exit and no worker is spawned in place of them
+	setWorkerCount(0u);
+
+	std::vector<std::thread> exitedWorkers;
+
+	{
+		std::lock_guard lock(_workersMutex);
+
+		for (std::thread& worker : _workers)
+		{
+			if (worker.joinable())
+			{
+				exitedWorkers.emplace_back(std::move(worker));
+			}
+		}
+	}
+
+	//Exiting workers lock the workers mutex, join them once it is released
+	for (std::thread& exitedWorker : exitedWorkers)
+	{
+		exitedWorker.join();
 	}
+
+	{
+		std::lock_guard lock(_taskMutex);
+
+		_targetWorkerCount = workerCount;
+	}
+}
+
+uint32 ThreadPool::getWorkerCount() const noexcept
+{
+	return _targetWorkerCount;
+}
+
+void ThreadPool::setIsCollectingStatistics(bool isCollectingStatistics) noexcept
+{
+	_isCollectingStatistics.store(isCollectingStatistics);
+}
+
+ThreadPoolStatistics ThreadPool::getStatistics() const noexcept
+{
+	ThreadPoolStatistics	statistics;
+	uint64					executedTaskCount	= 0u;
+	uint64					taskWaitDuration	= 0u;
+
+	auto getWorkerStatistics = [&executedTaskCount, &taskWaitDuration](WorkerCounters const& counters)
+	{
+		ThreadPoolStatistics::WorkerStatistics workerStatistics;
+
+		workerStatistics.busyDuration		= counters.busyDuration.load(std::memory_order_relaxed) * 1e-9f;
+		workerStatistics.idleDuration		= counters.idleDuration.load(std::memory_order_relaxed) * 1e-9f;
+		workerStatistics.executedTaskCount	= counters.executedTaskCount.load(std::memory_order_relaxed);
+		workerStatistics.stolenTaskCount	= counters.stolenTaskCount.load(std::memory_order_relaxed);
+		workerStatistics.contendedLockCount	= counters.contendedLockCount.load(std::memory_order_relaxed);
+
+		executedTaskCount	+= workerStatistics.executedTaskCount;
+		taskWaitDuration	+= counters.taskWaitDuration.load(std::memory_order_relaxed);
+
+		return workerStatistics;
+	};
+
+	statistics.workers.reserve(_workerQueues.size());
+
+	for (size_t i = 0u; i < _workerQueues.size(); i++)
+	{
+		statistics.workers.emplace_back(getWorkerStatistics(_workerCounters[i]));
+	}
+
+	statistics.externalThreads		= getWorkerStatistics(_workerCounters[_workerQueues.size()]);
+	statistics.maxQueuedTaskCount	= _maxQueuedTaskCount.load(std::memory_order_relaxed);
+
+	if (executedTaskCount != 0u)
+	{
+		statistics.averageTaskWaitDuration = (taskWaitDuration / executedTaskCount) * 1e-9f;
+	}
+
+	return statistics;
+}
+
+void ThreadPool::resetStatistics() noexcept
+{
+	for (size_t i = 0u; i <= _workerQueues.size(); i++)
+	{
+		WorkerCounters& counters = _workerCounters[i];
+
+		counters.busyDuration.store(0u, std::memory_order_relaxed);
+		counters.idleDuration.store(0u, std::memory_order_relaxed);
+		counters.executedTaskCount.store(0u, std::memory_order_relaxed);
+		counters.stolenTaskCount.store(0u, std::memory_order_relaxed);
+		counters.contendedLockCount.store(0u, std::memory_order_relaxed);
+		counters.taskWaitDuration.store(0u, std::memory_order_relaxed);
+	}
+
+	//Tasks which are still queued count for the next snapshot
+	_maxQueuedTaskCount.store(_queuedTaskCount, std::memory_order_relaxed);
+}
+
+uint32 ThreadPool::getCurrentWorkerIndex() const noexcept
+{
+	return (_currentWorkerPool == this) ? _currentWorkerIndex : getMaxWorkerCount();
+}
+
+uint32 ThreadPool::getMaxWorkerCount() const noexcept
+{
+	return static_cast<uint32>(_workerQueues.size());
 }
\ No newline at end of file
@@ -0,0 +1,627 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <Kodgen/CodeGen/CodeGenManager.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnit.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenModule.h>
+#include <Kodgen/CodeGen/Macro/MacroPropertyCodeGen.h>
+#include <Kodgen/Parsing/FileParser.h>
+#include <Kodgen/Misc/DefaultLogger.h>
+
+using namespace kodgen;
+
+/**
+*	Property code generator listing in the header file footer all the classes it has ever seen.
+*	It keeps state between files and doesn't support reuse, so each file must get a fresh copy of it.
+*/
+class SeenPropertyCodeGen : public MacroPropertyCodeGen
+{
+	private:
+		std::set<std::string>	_seenClasses;
+
+	public:
+		SeenPropertyCodeGen() noexcept:
+			MacroPropertyCodeGen("Seen", EEntityType::Class)
+		{}
+
+		virtual bool generateHeaderFileFooterCodeForEntity(EntityInfo const& entity, Property const& /* property */, uint8 /* propertyIndex */,
+														   MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			_seenClasses.insert(entity.name);
+
+			inout_result += "//Seen:";
+
+			for (std::string const& seenClass : _seenClasses)
+			{
+				inout_result += " " + seenClass;
+			}
+
+			inout_result += env.getSeparator();
+
+			return true;
+		}
+};
+
+/**
+*	Module opting in reuse, holding a property code generator which doesn't.
+*/
+class SeenCGM : public MacroCodeGenModule
+{
+	private:
+		SeenPropertyCodeGen	_seenPropertyCodeGen;
+
+	public:
+		SeenCGM() noexcept
+		{
+			addPropertyCodeGen(_seenPropertyCodeGen);
+		}
+
+		SeenCGM(SeenCGM const&):
+			SeenCGM()
+		{
+		}
+
+		virtual SeenCGM* clone() const noexcept override
+		{
+			return new SeenCGM(*this);
+		}
+
+		virtual bool supportsReuse() const noexcept override
+		{
+			return true;
+		}
+};
+
+/**
+*	Property code generator crashing the process generating a class, either always or only while a marker file exists.
+*	The marker file is removed before crashing, so that only the first process generating the class crashes.
+*/
+class CrashPropertyCodeGen : public MacroPropertyCodeGen
+{
+	private:
+		fs::path	_markerFile;
+
+	public:
+		CrashPropertyCodeGen(fs::path markerFile) noexcept:
+			MacroPropertyCodeGen("Crash", EEntityType::Class),
+			_markerFile{std::move(markerFile)}
+		{}
+
+		fs::path const& getMarkerFile() const noexcept
+		{
+			return _markerFile;
+		}
+
+		virtual bool generateHeaderFileFooterCodeForEntity(EntityInfo const& entity, Property const& /* property */, uint8 /* propertyIndex */,
+														   MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			if (entity.name == "Broken" || (entity.name == "CrashingOnce" && fs::remove(_markerFile)))
+			{
+				std::abort();
+			}
+
+			inout_result += "//Generated: " + entity.name + env.getSeparator();
+
+			return true;
+		}
+};
+
+/**
+*	Module holding a crashing property code generator.
+*/
+class CrashCGM : public MacroCodeGenModule
+{
+	private:
+		CrashPropertyCodeGen	_crashPropertyCodeGen;
+
+	public:
+		CrashCGM(fs::path markerFile) noexcept:
+			_crashPropertyCodeGen(std::move(markerFile))
+		{
+			addPropertyCodeGen(_crashPropertyCodeGen);
+		}
+
+		CrashCGM(CrashCGM const& other):
+			CrashCGM(other._crashPropertyCodeGen.getMarkerFile())
+		{
+		}
+
+		virtual CrashCGM* clone() const noexcept override
+		{
+			return new CrashCGM(*this);
+		}
+};
+
+static std::string readFile(fs::path const& path)
+{
+	std::ifstream		stream(path);
+	std::stringstream	content;
+
+	content << stream.rdbuf();
+
+	return content.str();
+}
+
+static bool initFileParser(FileParser& fileParser, DefaultLogger& logger)
+{
+	fileParser.logger = &logger;
+	fileParser.getSettings().propertyParsingSettings.classMacroName = "KGClass";
+
+	if (!fileParser.getSettings().setCompilerExeName("g++"))
+	{
+		std::cerr << "Failed to setup the compiler." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+*	Generate 2 files on a single thread with a stateful module, and check that the code generated for each file
+*	doesn't depend on the other one.
+*/
+static bool testThreadUnitReuse(fs::path const& workingDirectory, DefaultLogger& logger)
+{
+	fs::path includeDirectory	= workingDirectory / "Include";
+	fs::path outputDirectory	= workingDirectory / "Generated";
+
+	fs::create_directories(includeDirectory);
+
+	std::ofstream(includeDirectory / "First.h") << "#pragma once\n\nclass KGClass(Seen) First {};\n";
+	std::ofstream(includeDirectory / "Second.h") << "#pragma once\n\nclass KGClass(Seen) Second {};\n";
+
+	FileParser fileParser;
+
+	if (!initFileParser(fileParser, logger))
+	{
+		return false;
+	}
+
+	MacroCodeGenUnitSettings cguSettings;
+	cguSettings.setOutputDirectory(outputDirectory);
+
+	SeenCGM seenModule;
+
+	MacroCodeGenUnit codeGenUnit;
+	codeGenUnit.logger = &logger;
+	codeGenUnit.setSettings(cguSettings);
+	codeGenUnit.addModule(seenModule);
+
+	if (codeGenUnit.isReusable())
+	{
+		std::cerr << "A unit must not be reusable if one of its property code generators doesn't support reuse." << std::endl;
+		return false;
+	}
+
+	//A single thread generates all the files
+	CodeGenManager codeGenMgr(1u);
+	codeGenMgr.logger = &logger;
+	codeGenMgr.settings.addToProcessDirectory(includeDirectory);
+	codeGenMgr.settings.addSupportedFileExtension(".h");
+
+	CodeGenResult genResult = codeGenMgr.run(fileParser, codeGenUnit, true);
+
+	std::string firstGeneratedHeader	= readFile(outputDirectory / cguSettings.getGeneratedHeaderFileName(includeDirectory / "First.h"));
+	std::string secondGeneratedHeader	= readFile(outputDirectory / cguSettings.getGeneratedHeaderFileName(includeDirectory / "Second.h"));
+
+	if (!genResult.completed || genResult.parsedFiles.size() != 2u)
+	{
+		std::cerr << "The generation failed." << std::endl;
+		return false;
+	}
+
+	if (firstGeneratedHeader.find("//Seen: First") == std::string::npos || firstGeneratedHeader.find("Second") != std::string::npos ||
+		secondGeneratedHeader.find("//Seen: Second") == std::string::npos || secondGeneratedHeader.find("First") != std::string::npos)
+	{
+		std::cerr << "The code generated for a file depends on the other generated file:" << std::endl << firstGeneratedHeader << std::endl << secondGeneratedHeader << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+*	Generate files in worker processes, one of them crashing its worker once and another one crashing all its workers,
+*	and check that the first one is retried and that only the second one fails.
+*/
+static bool testShardWorkerCrash(fs::path const& workingDirectory, DefaultLogger& logger)
+{
+#if _WIN32
+	(void)workingDirectory;
+	(void)logger;
+
+	return true;
+#else
+	fs::path					includeDirectory	= workingDirectory / "Include";
+	fs::path					outputDirectory		= workingDirectory / "Generated";
+	fs::path					markerFile			= workingDirectory / "CrashMarker";
+	std::vector<std::string>	classNames			= { "CrashingOnce", "Broken", "First", "Second", "Third" };
+
+	fs::create_directories(includeDirectory);
+
+	for (std::string const& className : classNames)
+	{
+		std::ofstream(includeDirectory / (className + ".h")) << "#pragma once\n\nclass KGClass(Crash) " << className << " {};\n";
+	}
+
+	std::ofstream(markerFile) << "";
+
+	FileParser fileParser;
+
+	if (!initFileParser(fileParser, logger))
+	{
+		return false;
+	}
+
+	MacroCodeGenUnitSettings cguSettings;
+	cguSettings.setOutputDirectory(outputDirectory);
+
+	CrashCGM crashModule(markerFile);
+
+	MacroCodeGenUnit codeGenUnit;
+	codeGenUnit.logger = &logger;
+	codeGenUnit.setSettings(cguSettings);
+	codeGenUnit.addModule(crashModule);
+
+	//Worker threads are running when the worker processes are forked
+	CodeGenManager codeGenMgr(4u);
+	codeGenMgr.logger = &logger;
+	codeGenMgr.settings.addToProcessDirectory(includeDirectory);
+	codeGenMgr.settings.addSupportedFileExtension(".h");
+
+	CodeGenResult genResult = codeGenMgr.runSharded(fileParser, codeGenUnit, 2u, true);
+
+	if (genResult.completed)
+	{
+		std::cerr << "A generation with a file crashing all its workers must not complete." << std::endl;
+		return false;
+	}
+
+	if (fs::exists(markerFile))
+	{
+		std::cerr << "The worker processes didn't generate the file crashing once." << std::endl;
+		return false;
+	}
+
+	for (std::string const& className : classNames)
+	{
+		fs::path	file				= includeDirectory / (className + ".h");
+		std::string	generatedHeader		= readFile(outputDirectory / cguSettings.getGeneratedHeaderFileName(file));
+		bool		shouldBeGenerated	= (className != "Broken");
+
+		if ((generatedHeader.find("//Generated: " + className) != std::string::npos) != shouldBeGenerated)
+		{
+			std::cerr << className << (shouldBeGenerated ? " has not been generated after its worker crashed." : " has been generated although it crashes its workers.") << std::endl;
+			return false;
+		}
+
+		if (std::find(genResult.parsedFiles.cbegin(), genResult.parsedFiles.cend(), file) == genResult.parsedFiles.cend())
+		{
+			std::cerr << className << " is missing from the parsed files." << std::endl;
+			return false;
+		}
+	}
+
+	//The thread pool workers stopped before forking are spawned again by a generation in the current process
+	fs::remove(includeDirectory / "Broken.h");
+
+	genResult = codeGenMgr.run(fileParser, codeGenUnit, true);
+
+	if (!genResult.completed || genResult.parsedFiles.size() != classNames.size() - 1u)
+	{
+		std::cerr << "The generation in the current process failed after a sharded generation." << std::endl;
+		return false;
+	}
+
+	return true;
+#endif
+}
+
+/**
+*	Regenerate files after various changes, and check that the manifest only makes the files which must be regenerated parsed again.
+*/
+static bool testManifest(fs::path const& workingDirectory, DefaultLogger& logger)
+{
+	fs::path	includeDirectory	= workingDirectory / "Include";
+	fs::path	outputDirectory		= workingDirectory / "Generated";
+	fs::path	firstFile			= includeDirectory / "First.h";
+	fs::path	secondFile			= includeDirectory / "Second.h";
+
+	fs::create_directories(includeDirectory);
+
+	std::ofstream(firstFile) << "#pragma once\n\nclass KGClass(Seen) First {};\n";
+	std::ofstream(secondFile) << "#pragma once\n\nclass KGClass(Seen) Second {};\n";
+
+	FileParser fileParser;
+
+	if (!initFileParser(fileParser, logger))
+	{
+		return false;
+	}
+
+	MacroCodeGenUnitSettings cguSettings;
+	cguSettings.setOutputDirectory(outputDirectory);
+
+	SeenCGM seenModule;
+
+	MacroCodeGenUnit codeGenUnit;
+	codeGenUnit.logger = &logger;
+	codeGenUnit.setSettings(cguSettings);
+	codeGenUnit.addModule(seenModule);
+
+	CodeGenManager codeGenMgr(1u);
+	codeGenMgr.logger = &logger;
+	codeGenMgr.settings.addToProcessDirectory(includeDirectory);
+	codeGenMgr.settings.addSupportedFileExtension(".h");
+
+	auto checkGeneration = [&](char const* step, size_t expectedParsedFileCount)
+	{
+		CodeGenResult genResult = codeGenMgr.run(fileParser, codeGenUnit);
+
+		if (!genResult.completed || genResult.parsedFiles.size() != expectedParsedFileCount)
+		{
+			std::cerr << step << ": " << genResult.parsedFiles.size() << " files have been parsed instead of " << expectedParsedFileCount << "." << std::endl;
+			return false;
+		}
+
+		return true;
+	};
+
+	if (!checkGeneration("First generation", 2u) ||
+		!checkGeneration("Generation without change", 0u))
+	{
+		return false;
+	}
+
+	//Files are compared by content, not by timestamp
+	fs::last_write_time(firstFile, fs::last_write_time(firstFile) + std::chrono::hours(1));
+
+	if (!checkGeneration("Generation after a file has been touched", 0u))
+	{
+		return false;
+	}
+
+	std::ofstream(firstFile, std::ios::app) << "\n//Edited\n";
+
+	if (!checkGeneration("Generation after a file has been edited", 1u))
+	{
+		return false;
+	}
+
+	//Any change of the generation setup regenerates all the files
+	cguSettings.setExportSymbolMacroName("SOME_EXPORT");
+
+	if (!checkGeneration("Generation after a unit setting changed", 2u))
+	{
+		return false;
+	}
+
+	CrashCGM otherModule(workingDirectory / "NoCrashMarker");
+	codeGenUnit.addModule(otherModule);
+
+	if (!checkGeneration("Generation after a module has been added", 2u))
+	{
+		return false;
+	}
+
+	//The entry of a deleted source is removed, even if no other file must be regenerated
+	fs::remove(secondFile);
+
+	CodeGenManifest manifest;
+
+	if (!checkGeneration("Generation after a file has been deleted", 0u) ||
+		!manifest.loadFromFile(outputDirectory / CodeGenManifest::manifestFilename) ||
+		manifest.getEntry(firstFile) == nullptr || manifest.getEntry(secondFile) != nullptr)
+	{
+		std::cerr << "The manifest entry of a deleted file has not been removed." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+*	Edit a header included by some processed files, and check that only the files including it are regenerated.
+*	The header isn't processed so that it can be precompiled: with a precompiled header, the dependency comes from the precompiled header included files.
+*/
+static bool testIncludeDependencies(fs::path const& workingDirectory, DefaultLogger& logger, bool usePrecompiledHeader)
+{
+	fs::path	includeDirectory	= workingDirectory / "Include";
+	fs::path	outputDirectory		= workingDirectory / "Generated";
+	fs::path	commonFile			= workingDirectory / "Common" / "Common.h";
+	fs::path	firstFile			= includeDirectory / "First.h";
+	fs::path	secondFile			= includeDirectory / "Second.h";
+	fs::path	unrelatedFile		= includeDirectory / "Unrelated.h";
+
+	fs::create_directories(includeDirectory);
+	fs::create_directories(commonFile.parent_path());
+
+	std::ofstream(commonFile) << "#pragma once\n\nclass Common {};\n";
+	std::ofstream(firstFile) << "#pragma once\n\n#include \"../Common/Common.h\"\n\nclass KGClass(Seen) First { Common c; };\n";
+	std::ofstream(secondFile) << "#pragma once\n\n#include \"../Common/Common.h\"\n\nclass KGClass(Seen) Second { Common c; };\n";
+	std::ofstream(unrelatedFile) << "#pragma once\n\nclass KGClass(Seen) Unrelated {};\n";
+
+	FileParser fileParser;
+
+	if (!initFileParser(fileParser, logger))
+	{
+		return false;
+	}
+
+	fileParser.getSettings().shouldUsePrecompiledHeader = usePrecompiledHeader;
+
+	MacroCodeGenUnitSettings cguSettings;
+	cguSettings.setOutputDirectory(outputDirectory);
+
+	SeenCGM seenModule;
+
+	MacroCodeGenUnit codeGenUnit;
+	codeGenUnit.logger = &logger;
+	codeGenUnit.setSettings(cguSettings);
+	codeGenUnit.addModule(seenModule);
+
+	CodeGenManager codeGenMgr(1u);
+	codeGenMgr.logger = &logger;
+	codeGenMgr.settings.addToProcessDirectory(includeDirectory);
+	codeGenMgr.settings.addSupportedFileExtension(".h");
+
+	CodeGenResult firstResult = codeGenMgr.run(fileParser, codeGenUnit);
+
+	if (!firstResult.completed || firstResult.parsedFiles.size() != 3u)
+	{
+		std::cerr << "Failed to generate the files depending on " << commonFile << std::endl;
+		return false;
+	}
+
+	//Make sure the dependency has been found through the precompiled header
+	if (usePrecompiledHeader)
+	{
+		std::shared_ptr<PrecompiledHeader> const& precompiledHeader = fileParser.getPrecompiledHeader();
+
+		if (precompiledHeader == nullptr ||
+			std::find(precompiledHeader->getIncludedFiles().cbegin(), precompiledHeader->getIncludedFiles().cend(), commonFile) == precompiledHeader->getIncludedFiles().cend())
+		{
+			std::cerr << "The files have not been parsed with a precompiled header including " << commonFile << std::endl;
+			return false;
+		}
+	}
+
+	std::ofstream(commonFile, std::ios::app) << "\nclass OtherCommon {};\n";
+
+	CodeGenResult genResult = codeGenMgr.run(fileParser, codeGenUnit);
+
+	std::sort(genResult.parsedFiles.begin(), genResult.parsedFiles.end());
+
+	if (!genResult.completed || genResult.parsedFiles != std::vector<fs::path>{ firstFile, secondFile })
+	{
+		std::cerr << "Only the files depending on " << commonFile << " should be regenerated when it is edited." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+*	Watch the files to process, edit a header included from outside of the directories to process,
+*	and check that the files including it are regenerated before watching is stopped.
+*/
+static bool testWatchDependencies(fs::path const& workingDirectory, DefaultLogger& logger)
+{
+#if !__linux__
+	(void)workingDirectory;
+	(void)logger;
+
+	return true;
+#else
+	fs::path	includeDirectory	= workingDirectory / "Include";
+	fs::path	outputDirectory		= workingDirectory / "Generated";
+	fs::path	commonFile			= workingDirectory / "Common" / "Common.h";
+	fs::path	firstFile			= includeDirectory / "First.h";
+	fs::path	unrelatedFile		= includeDirectory / "Unrelated.h";
+
+	fs::create_directories(includeDirectory);
+	fs::create_directories(commonFile.parent_path());
+
+	std::ofstream(commonFile) << "#pragma once\n\nclass Common {};\n";
+	std::ofstream(firstFile) << "#pragma once\n\n#include \"../Common/Common.h\"\n\nclass KGClass(Seen) First { Common c; };\n";
+	std::ofstream(unrelatedFile) << "#pragma once\n\nclass KGClass(Seen) Unrelated {};\n";
+
+	FileParser fileParser;
+
+	if (!initFileParser(fileParser, logger))
+	{
+		return false;
+	}
+
+	MacroCodeGenUnitSettings cguSettings;
+	cguSettings.setOutputDirectory(outputDirectory);
+
+	SeenCGM seenModule;
+
+	MacroCodeGenUnit codeGenUnit;
+	codeGenUnit.logger = &logger;
+	codeGenUnit.setSettings(cguSettings);
+	codeGenUnit.addModule(seenModule);
+
+	CodeGenManager codeGenMgr(1u);
+	codeGenMgr.logger = &logger;
+	codeGenMgr.settings.addToProcessDirectory(includeDirectory);
+	codeGenMgr.settings.addSupportedFileExtension(".h");
+
+	std::mutex					resultsMutex;
+	std::condition_variable		resultsCondition;
+	std::vector<CodeGenResult>	results;
+	bool						isWatchSuccessful = false;
+
+	std::thread watchThread([&]()
+							{
+								isWatchSuccessful = codeGenMgr.watch(fileParser, codeGenUnit, [&](CodeGenResult const& genResult)
+																	 {
+																		 std::lock_guard lock(resultsMutex);
+
+																		 results.push_back(genResult);
+																		 resultsCondition.notify_all();
+																	 });
+							});
+
+	auto waitForResults = [&](size_t resultCount)
+	{
+		std::unique_lock lock(resultsMutex);
+
+		return resultsCondition.wait_for(lock, std::chrono::seconds(10), [&]() { return results.size() >= resultCount; });
+	};
+
+	bool isSuccess = waitForResults(1u);
+
+	if (isSuccess)
+	{
+		std::ofstream(commonFile, std::ios::app) << "\nclass OtherCommon {};\n";
+
+		isSuccess = waitForResults(2u);
+	}
+
+	codeGenMgr.stopWatching();
+	watchThread.join();
+
+	if (!isSuccess || !isWatchSuccessful)
+	{
+		std::cerr << "Watching didn't regenerate the files after " << commonFile << " has been edited." << std::endl;
+		return false;
+	}
+	else if (!results[0].completed || results[0].parsedFiles.size() != 2u ||
+			 !results[1].completed || results[1].parsedFiles != std::vector<fs::path>{ firstFile })
+	{
+		std::cerr << "Only the files depending on " << commonFile << " should be regenerated when it is edited while watching." << std::endl;
+		return false;
+	}
+
+	return true;
+#endif
+}
+
+int main()
+{
+	DefaultLogger	logger;
+	fs::path		workingDirectory = fs::temp_directory_path() / "KodgenCodeGenTests";
+
+	fs::remove_all(workingDirectory);
+
+	bool succeeded = testThreadUnitReuse(workingDirectory / "ThreadUnitReuse", logger) &&
+					 testManifest(workingDirectory / "Manifest", logger) &&
+					 testIncludeDependencies(workingDirectory / "IncludeDependencies", logger, false) &&
+					 testIncludeDependencies(workingDirectory / "PrecompiledHeaderDependencies", logger, true) &&
+					 testWatchDependencies(workingDirectory / "WatchDependencies", logger) &&
+					 testShardWorkerCrash(workingDirectory / "ShardWorkerCrash", logger);
+
+	fs::remove_all(workingDirectory);
+
+	return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
@@ -0,0 +1,412 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>	//std::istringstream
+#include <vector>
+#include <string>
+#include <algorithm>	//std::all_of, std::find
+#include <limits>		//std::numeric_limits
+#include <memory>		//std::shared_ptr
+
+#include <Kodgen/Parsing/FileParser.h>
+#include <Kodgen/Parsing/PrecompiledHeader.h>
+#include <Kodgen/Parsing/TranslationUnitCache.h>
+#include <Kodgen/Misc/DefaultLogger.h>
+
+using namespace kodgen;
+
+/**
+*	@brief Setup a parser parsing classes annotated with KGClass.
+*
+*	@return true if the parser could be setup, else false.
+*/
+static bool initFileParser(FileParser& fileParser, ILogger& logger, bool usePrecompiledHeader, bool reuseTranslationUnits)
+{
+	fileParser.logger = &logger;
+
+	ParsingSettings& settings = fileParser.getSettings();
+	settings.propertyParsingSettings.classMacroName	= "KGClass";
+	settings.shouldUsePrecompiledHeader				= usePrecompiledHeader;
+	settings.shouldReuseTranslationUnits			= reuseTranslationUnits;
+
+	if (!settings.setCompilerExeName("g++"))
+	{
+		std::cerr << "Failed to setup the compiler." << std::endl;
+		return false;
+	}
+
+	settings.init(&logger);
+
+	return true;
+}
+
+/**
+*	Reparsing a file with a reused translation unit and a precompiled header must report the same included files
+*	as the first parsing, all of them existing on the disk.
+*/
+static bool testReparseIncludedFiles(fs::path const& workingDirectory, ILogger& logger)
+{
+	std::vector<fs::path> files = { workingDirectory / "First.h", workingDirectory / "Second.h" };
+
+	std::ofstream(files[0]) << "#pragma once\n\n#include <string>\n#include <vector>\n\nclass KGClass() First { std::string s; };\n";
+	std::ofstream(files[1]) << "#pragma once\n\n#include <string>\n#include <vector>\n\nclass KGClass() Second { std::vector<int> v; };\n";
+
+	FileParser fileParser;
+
+	if (!initFileParser(fileParser, logger, true, true))
+	{
+		return false;
+	}
+
+	if (!fileParser.preparePrecompiledHeader(files, {}))
+	{
+		std::cerr << "Failed to build the precompiled header." << std::endl;
+		return false;
+	}
+
+	FileParsingResult firstResult;
+	FileParsingResult reparseResult;
+
+	if (!fileParser.parse(files[0], firstResult) || !fileParser.parse(files[0], reparseResult))
+	{
+		std::cerr << "Failed to parse " << files[0] << std::endl;
+		return false;
+	}
+
+	if (firstResult.includedFiles.empty() || reparseResult.includedFiles != firstResult.includedFiles ||
+		!std::all_of(reparseResult.includedFiles.cbegin(), reparseResult.includedFiles.cend(), [](fs::path const& includedFile) { return fs::exists(includedFile); }))
+	{
+		std::cerr << "The files included by a reparsed file changed: " << firstResult.includedFiles.size() << " files then " << reparseResult.includedFiles.size() << " files." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+*	Parse a file which only exists in memory and includes an in-memory header, then reparse it after editing both of them.
+*/
+static bool testInMemoryParsing(fs::path const& workingDirectory, ILogger& logger)
+{
+	//Neither the parsed file nor the header exist on the disk
+	fs::path parsedFile	= workingDirectory / "InMemory" / "Main.h";
+	fs::path header		= workingDirectory / "InMemory" / "Virtual.h";
+
+	FileParser fileParser;
+
+	if (!initFileParser(fileParser, logger, false, true))
+	{
+		return false;
+	}
+
+	std::vector<std::string> const classNames	= { "First", "Second" };
+	std::vector<std::string> const structNames	= { "Bar", "Baz" };
+
+	//The second iteration reparses the reused translation unit with the edited contents
+	for (size_t i = 0u; i < classNames.size(); i++)
+	{
+		std::string					content		= "#include \"Virtual.h\"\n\nclass KGClass() " + classNames[i] + " { " + structNames[i] + " member; };\n";
+		std::vector<UnsavedFile>	overlays	= { { header, "#pragma once\n\nstruct " + structNames[i] + " {};\n" } };
+		FileParsingResult			result;
+
+		if (!fileParser.parse(parsedFile, content, overlays, result) || result.hasCompilationErrors)
+		{
+			std::cerr << "Failed to parse the in-memory file " << parsedFile << std::endl;
+			return false;
+		}
+
+		if (result.parsedFile != parsedFile || result.classes.size() != 1u || result.classes[0].name != classNames[i] ||
+			std::find(result.includedFiles.cbegin(), result.includedFiles.cend(), header) == result.includedFiles.cend())
+		{
+			std::cerr << "The result of the in-memory file parsing doesn't match its content." << std::endl;
+			return false;
+		}
+	}
+
+	return !fs::exists(workingDirectory / "InMemory");
+}
+
+/**
+*	An in-memory header replacing a header of the precompiled header prelude must be used instead of the precompiled header.
+*/
+static bool testPrecompiledHeaderOverlay(fs::path const& workingDirectory, ILogger& logger)
+{
+	fs::path parsedFile	= workingDirectory / "Main.h";
+	fs::path prelude	= workingDirectory / "Prelude.h";
+
+	std::ofstream(prelude) << "#pragma once\n\nstruct Common {};\n";
+
+	FileParser fileParser;
+	fileParser.getSettings().precompiledHeaderPrelude = prelude;
+
+	if (!initFileParser(fileParser, logger, true, true) || !fileParser.preparePrecompiledHeader({}, {}))
+	{
+		std::cerr << "Failed to build the precompiled header." << std::endl;
+		return false;
+	}
+
+	FileParsingResult withPrecompiledHeaderResult;
+	FileParsingResult overlayResult;
+
+	bool isSuccess = fileParser.parse(parsedFile, "#include \"Prelude.h\"\n\nclass KGClass() First { Common c; };\n", {}, withPrecompiledHeaderResult) &&
+					 !withPrecompiledHeaderResult.hasCompilationErrors &&
+					 fileParser.parse(parsedFile, "#include \"Prelude.h\"\n\nclass KGClass() First { Common c; Overlaid o; };\n",
+									  { { prelude, "#pragma once\n\nstruct Common {};\nstruct Overlaid {};\n" } }, overlayResult) &&
+					 !overlayResult.hasCompilationErrors && overlayResult.classes.size() == 1u;
+
+	if (!isSuccess)
+	{
+		std::cerr << "The in-memory content of a header of the precompiled header prelude is ignored." << std::endl;
+	}
+
+	return isSuccess;
+}
+
+/**
+*	@brief Describe all the entities of a parsing result, with their ids.
+*/
+static std::string describeEntities(FileParsingResult const& result)
+{
+	std::string description;
+
+	result.foreachEntityOfType(EEntityType::Namespace | EEntityType::Class | EEntityType::Struct | EEntityType::Enum | EEntityType::EnumValue |
+							   EEntityType::Variable | EEntityType::Field | EEntityType::Function | EEntityType::Method,
+							   [&description](EntityInfo const& entity)
+							   {
+								   description += entity.getFullName() + " " + entity.id + "\n";
+							   });
+
+	return description;
+}
+
+/**
+*	getLeadingIncludes must skip comments, #pragma once and include guards, stop at the first other code,
+*	and resolve the quoted includes found next to the file.
+*/
+static bool testLeadingIncludes(fs::path const& workingDirectory)
+{
+	fs::path file = workingDirectory / "Leading.h";
+
+	std::ofstream(workingDirectory / "Local.h") << "#pragma once\n";
+
+	std::string const localInclude = "\"" + FilesystemHelpers::normalizeSeparator(FilesystemHelpers::sanitizePath(workingDirectory / "Local.h")).string() + "\"";
+
+	std::vector<std::pair<std::string, std::vector<std::string>>> const cases =
+	{
+		//Comments and #pragma once
+		{ "/*\n*\tLicense\n*/\n\n#pragma once\n\n//Comment\n#include <vector>\n/* Comment */ #include <string>\n#include <map>\t//Comment\n\nclass A;\n#include <set>\n", { "<vector>", "<string>", "<map>" } },
+		{ "#include <vector>\n/* Comment */ int i;\n#include <string>\n", { "<vector>" } },
+		{ "#pragma pack(1)\n#include <vector>\n", { } },
+
+		//Include guards
+		{ "#ifndef LEADING_H\n#define LEADING_H\n\n#include <vector>\n#include <string>\n\n#endif\n", { "<vector>", "<string>" } },
+		{ "#ifndef LEADING_H\n#define OTHER_MACRO\n#include <vector>\n", { } },
+		{ "#include <vector>\n#ifndef SOME_MACRO\n#include <string>\n#endif\n", { "<vector>" } },
+
+		//Quoted includes
+		{ "#include \"Local.h\"\n#include \"Missing.h\"\n", { localInclude, "\"Missing.h\"" } }
+	};
+
+	for (auto const& [content, expectedIncludes] : cases)
+	{
+		std::istringstream stream(content);
+
+		if (PrecompiledHeader::getLeadingIncludes(file, stream) != expectedIncludes)
+		{
+			std::cerr << "Wrong leading includes for content:" << std::endl << content << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+*	findCommonIncludePrefix must pick the prefix maximizing its length times the number of files starting with it, shared by 2 files at least.
+*/
+static bool testCommonIncludePrefix(fs::path const& workingDirectory)
+{
+	std::vector<fs::path> files = { workingDirectory / "Prefix1.h", workingDirectory / "Prefix2.h", workingDirectory / "Prefix3.h" };
+
+	std::ofstream(files[0]) << "#include <vector>\n#include <string>\n#include <map>\n";
+	std::ofstream(files[1]) << "#pragma once\n#include <vector>\n#include <string>\n";
+	std::ofstream(files[2]) << "#include <vector>\n#include <set>\n";
+
+	if (PrecompiledHeader::findCommonIncludePrefix(files) != std::vector<std::string>{ "<vector>", "<string>" } ||
+		!PrecompiledHeader::findCommonIncludePrefix({ files[0] }).empty())
+	{
+		std::cerr << "Wrong common include prefix." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+*	A prelude including generated files is halved until it doesn't, and a prelude stops before the first header without include guard.
+*/
+static bool testPrecompiledHeaderPrelude(fs::path const& workingDirectory, ILogger& logger)
+{
+	fs::path				generatedDirectory	= workingDirectory / "Generated";
+	std::vector<fs::path>	files				= { workingDirectory / "Prelude1.h", workingDirectory / "Prelude2.h" };
+
+	fs::create_directories(generatedDirectory);
+
+	std::ofstream(generatedDirectory / "Generated.h") << "#pragma once\n";
+	std::ofstream(workingDirectory / "Unguarded.h") << "struct Unguarded {};\n";
+
+	std::ofstream(files[0]) << "#include <vector>\n#include \"Generated/Generated.h\"\n\nclass KGClass() First {};\n";
+	std::ofstream(files[1]) << "#include <vector>\n#include \"Generated/Generated.h\"\n\nclass KGClass() Second {};\n";
+
+	FileParser fileParser;
+
+	if (!initFileParser(fileParser, logger, true, false))
+	{
+		return false;
+	}
+
+	if (!fileParser.preparePrecompiledHeader(files, { generatedDirectory }) ||
+		fileParser.getPrecompiledHeader()->getPreludeIncludes() != std::vector<std::string>{ "<vector>" })
+	{
+		std::cerr << "A prelude including generated files must be halved." << std::endl;
+		return false;
+	}
+
+	std::ofstream(files[0]) << "#include <vector>\n#include \"Unguarded.h\"\n\nclass KGClass() First { Unguarded u; };\n";
+	std::ofstream(files[1]) << "#include <vector>\n#include \"Unguarded.h\"\n\nclass KGClass() Second { Unguarded u; };\n";
+
+	//The current precompiled header would be kept while it is up to date, so use another parser
+	FileParser			otherFileParser;
+	FileParsingResult	result;
+
+	if (!initFileParser(otherFileParser, logger, true, false))
+	{
+		return false;
+	}
+
+	if (!otherFileParser.preparePrecompiledHeader(files, {}) ||
+		otherFileParser.getPrecompiledHeader()->getPreludeIncludes() != std::vector<std::string>{ "<vector>" } ||
+		!otherFileParser.parse(files[0], result) || result.hasCompilationErrors)
+	{
+		std::cerr << "A prelude must not include headers without include guard." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+*	Parsing files with a precompiled header must give the same results as parsing them without.
+*/
+static bool testPrecompiledHeaderResults(fs::path const& workingDirectory, ILogger& logger)
+{
+	std::vector<fs::path> files = { workingDirectory / "Results1.h", workingDirectory / "Results2.h" };
+
+	std::ofstream(files[0]) << "#pragma once\n\n#include <string>\n#include <vector>\n\nnamespace NAMESPACE() Space\n{\n"
+							   "\tclass KGClass() First { FIELD() std::string s; METHOD() void m(); };\n"
+							   "\tenum class ENUM() E { ENUMVALUE() A, B };\n}\n\nFUNCTION() int f(std::vector<int> const& v);\n";
+	std::ofstream(files[1]) << "#pragma once\n\n#include <string>\n#include <vector>\n#include <map>\n\n"
+							   "struct STRUCT() Second { FIELD() std::map<int, std::string> m; };\n\nVARIABLE() std::vector<int> v;\n";
+
+	FileParser withoutPrecompiledHeader;
+	FileParser withPrecompiledHeader;
+
+	if (!initFileParser(withoutPrecompiledHeader, logger, false, false) || !initFileParser(withPrecompiledHeader, logger, true, false))
+	{
+		return false;
+	}
+
+	if (!withPrecompiledHeader.preparePrecompiledHeader(files, {}))
+	{
+		std::cerr << "Failed to build the precompiled header." << std::endl;
+		return false;
+	}
+
+	for (fs::path const& file : files)
+	{
+		FileParsingResult withoutResult;
+		FileParsingResult withResult;
+
+		if (!withoutPrecompiledHeader.parse(file, withoutResult) || !withPrecompiledHeader.parse(file, withResult))
+		{
+			std::cerr << "Failed to parse " << file << std::endl;
+			return false;
+		}
+
+		if (describeEntities(withResult).empty() || describeEntities(withResult) != describeEntities(withoutResult) ||
+			withResult.includedFiles != withoutResult.includedFiles || withResult.hasCompilationErrors != withoutResult.hasCompilationErrors)
+		{
+			std::cerr << "Parsing " << file << " with a precompiled header gives a different result:" << std::endl
+					  << describeEntities(withResult) << withResult.includedFiles.size() << " included files" << std::endl
+					  << describeEntities(withoutResult) << withoutResult.includedFiles.size() << " included files" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+*	Releasing a translation unit for a file which already has a cached translation unit must replace it,
+*	so that the file is never reparsed with an outdated translation unit.
+*/
+static bool testTranslationUnitCacheReplacement(fs::path const& workingDirectory)
+{
+	fs::path file = workingDirectory / "Cached.h";
+
+	std::ofstream(file) << "#pragma once\n\nclass Cached {};\n";
+
+	std::shared_ptr<void>	clangIndex(clang_createIndex(0, 0), &clang_disposeIndex);
+	CXTranslationUnit		firstTranslationUnit	= clang_parseTranslationUnit(clangIndex.get(), file.string().c_str(), nullptr, 0, nullptr, 0, CXTranslationUnit_None);
+	CXTranslationUnit		secondTranslationUnit	= clang_parseTranslationUnit(clangIndex.get(), file.string().c_str(), nullptr, 0, nullptr, 0, CXTranslationUnit_None);
+
+	if (firstTranslationUnit == nullptr || secondTranslationUnit == nullptr)
+	{
+		std::cerr << "Failed to parse " << file << std::endl;
+		return false;
+	}
+
+	TranslationUnitCache	cache;
+	std::shared_ptr<void>	acquiredClangIndex;
+
+	cache.release(file, firstTranslationUnit, clangIndex, 0u, std::numeric_limits<uint64>::max());
+	cache.release(file, secondTranslationUnit, clangIndex, 0u, std::numeric_limits<uint64>::max());
+
+	CXTranslationUnit	acquiredTranslationUnit	= cache.acquire(file, 0u, acquiredClangIndex);
+	bool				isSuccess				= acquiredTranslationUnit == secondTranslationUnit && cache.acquire(file, 0u, acquiredClangIndex) == nullptr;
+
+	if (acquiredTranslationUnit != nullptr)
+	{
+		clang_disposeTranslationUnit(acquiredTranslationUnit);
+	}
+
+	if (!isSuccess)
+	{
+		std::cerr << "The translation unit cached for " << file << " has not been replaced." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	DefaultLogger logger;
+
+	fs::path workingDirectory = fs::temp_directory_path() / "KodgenParsingTests";
+
+	fs::remove_all(workingDirectory);
+	fs::create_directories(workingDirectory);
+
+	bool succeeded = testReparseIncludedFiles(workingDirectory, logger) &&
+					 testInMemoryParsing(workingDirectory, logger) &&
+					 testPrecompiledHeaderOverlay(workingDirectory, logger) &&
+					 testLeadingIncludes(workingDirectory) &&
+					 testCommonIncludePrefix(workingDirectory) &&
+					 testPrecompiledHeaderPrelude(workingDirectory, logger) &&
+					 testPrecompiledHeaderResults(workingDirectory, logger) &&
+					 testTranslationUnitCacheReplacement(workingDirectory);
+
+	fs::remove_all(workingDirectory);
+
+	return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
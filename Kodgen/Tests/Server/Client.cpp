@@ -0,0 +1,65 @@
+#include <iostream>
+#include <string>
+
+#include <Kodgen/CodeGen/CodeGenProtocol.h>
+
+using namespace kodgen;
+
+/**
+*	Minimal client of a CodeGenServer, as a build system would call it for each target.
+*	Usage: KodgenClient <socketPath> [--force] [--file <path>] [--directory <path>] [--ignoredFile <path>] [--ignoredDirectory <path>]...
+*/
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <socketPath> [--force] [--file <path>] [--directory <path>] [--ignoredFile <path>] [--ignoredDirectory <path>]..." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	CodeGenRequest request;
+
+	for (int i = 2; i < argc; i++)
+	{
+		std::string option = argv[i];
+
+		if (option == "--force")
+		{
+			request.forceRegenerateAll = true;
+		}
+		else if (i + 1 < argc && option == "--file")
+		{
+			request.toProcessFiles.emplace_back(argv[++i]);
+		}
+		else if (i + 1 < argc && option == "--directory")
+		{
+			request.toProcessDirectories.emplace_back(argv[++i]);
+		}
+		else if (i + 1 < argc && option == "--ignoredFile")
+		{
+			request.ignoredFiles.emplace_back(argv[++i]);
+		}
+		else if (i + 1 < argc && option == "--ignoredDirectory")
+		{
+			request.ignoredDirectories.emplace_back(argv[++i]);
+		}
+		else
+		{
+			std::cerr << "Unknown option " << option << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	LocalSocket		socket;
+	CodeGenResult	genResult;
+
+	if (!socket.connect(argv[1]) || !CodeGenProtocol::sendRequest(socket, request) || !CodeGenProtocol::receiveResult(socket, genResult))
+	{
+		std::cerr << "Could not communicate with the server listening to " << argv[1] << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "completed=" << genResult.completed << " parsed=" << genResult.parsedFiles.size() << " upToDate=" << genResult.upToDateFiles.size() << std::endl;
+
+	return genResult.completed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <sstream>
+
+#include <Kodgen/CodeGen/CodeGenServer.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnit.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h>
+#include <Kodgen/Misc/DefaultLogger.h>
+#include <Kodgen/Misc/System.h>
+
+using namespace kodgen;
+
+/**
+*	Logger counting the errors it logs, since a generation can complete without parsing anything when the parser is misconfigured.
+*/
+class ErrorCountingLogger : public DefaultLogger
+{
+	public:
+		std::atomic_uint	errorCount = 0u;
+
+		virtual void logError(std::string const& message) noexcept override
+		{
+			errorCount++;
+
+			DefaultLogger::logError(message);
+		}
+};
+
+static std::string readFile(fs::path const& path)
+{
+	std::ifstream		stream(path);
+	std::stringstream	content;
+
+	content << stream.rdbuf();
+
+	return content.str();
+}
+
+/**
+*	Serve requests in a thread and send them through the stand-in client executable.
+*	Usage: ServerTests <clientExecutablePath>
+*/
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cerr << "The path to the client executable must be provided as first program argument." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	ErrorCountingLogger logger;
+
+	//Setup a small project to process
+	fs::path workingDirectory	= fs::temp_directory_path() / "KodgenServerTests";
+	fs::path includeDirectory	= workingDirectory / "Include";
+	fs::path socketPath			= workingDirectory / "Kodgen.sock";
+
+	fs::remove_all(workingDirectory);
+	fs::create_directories(includeDirectory);
+
+	std::ofstream(includeDirectory / "SomeClass.h") << "#pragma once\n\nclass SomeClass {};\n";
+	std::ofstream(includeDirectory / "SomeOtherClass.h") << "#pragma once\n\nclass SomeOtherClass {};\n";
+
+	FileParser fileParser;
+	fileParser.logger = &logger;
+
+	if (!fileParser.getSettings().setCompilerExeName("g++"))
+	{
+		std::cerr << "Failed to setup the compiler." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	MacroCodeGenUnitSettings cguSettings;
+	cguSettings.setOutputDirectory(workingDirectory / "Generated");
+
+	MacroCodeGenUnit codeGenUnit;
+	codeGenUnit.logger = &logger;
+	codeGenUnit.setSettings(cguSettings);
+
+	CodeGenManager codeGenMgr;
+	codeGenMgr.logger = &logger;
+	codeGenMgr.settings.addSupportedFileExtension(".h");
+
+	CodeGenServer server;
+	server.logger				= &logger;
+	server.clientTimeout		= std::chrono::milliseconds(200);
+	server.maxRequestLineLength	= 1024u;
+
+	if (!server.start(socketPath))
+	{
+		return EXIT_FAILURE;
+	}
+
+	std::thread serverThread([&]()
+							 {
+								 server.serve(codeGenMgr, fileParser, codeGenUnit);
+							 });
+
+	auto request = [&](std::string const& arguments, fs::path const& clientWorkingDirectory = fs::path())
+	{
+		std::string changeDirectory = clientWorkingDirectory.empty() ? std::string() : "cd \"" + clientWorkingDirectory.string() + "\" && ";
+
+		return System::executeCommand(changeDirectory + "\"" + std::string(argv[1]) + "\" \"" + socketPath.string() + "\" " + arguments);
+	};
+
+	std::string const directoryArgument = "--directory \"" + includeDirectory.string() + "\"";
+	std::string const fileArgument		= "--file \"" + (includeDirectory / "SomeClass.h").string() + "\"";
+
+	//Each request gets the result of its own generation
+	bool succeeded = request(directoryArgument) == "completed=1 parsed=2 upToDate=0\n" &&
+					 request(directoryArgument) == "completed=1 parsed=0 upToDate=2\n" &&
+					 request(fileArgument) == "completed=1 parsed=0 upToDate=1\n" &&
+					 request(fileArgument + " --force") == "completed=1 parsed=1 upToDate=0\n" &&
+					 request("--file Include/SomeClass.h --force", workingDirectory) == "completed=1 parsed=1 upToDate=0\n" &&
+					 request("--unknownOption").empty();
+
+	//The server rejects relative paths, which it would resolve against its own working directory
+	LocalSocket		relativePathClient;
+	CodeGenResult	relativePathResult;
+
+	relativePathResult.completed = true;
+
+	succeeded = succeeded &&
+				relativePathClient.connect(socketPath) &&
+				relativePathClient.send("KodgenRequest 1\nfile Include/SomeClass.h\nend\n") &&
+				CodeGenProtocol::receiveResult(relativePathClient, relativePathResult) && !relativePathResult.completed;
+
+	//A second server can't replace the socket of a running server, nor any other file
+	CodeGenServer	otherServer;
+	fs::path		regularFile = workingDirectory / "NotASocket";
+
+	std::ofstream(regularFile) << "Some content";
+
+	succeeded = succeeded &&
+				!otherServer.start(socketPath) &&
+				request(fileArgument) == "completed=1 parsed=0 upToDate=1\n" &&
+				!otherServer.start(regularFile) &&
+				readFile(regularFile) == "Some content";
+
+	//A client which stalls or sends a too long line is dropped without blocking the following requests
+	LocalSocket		stalledClient;
+	LocalSocket		floodingClient;
+	CodeGenResult	floodingResult;
+
+	floodingResult.completed = true;
+
+	succeeded = succeeded &&
+				stalledClient.connect(socketPath) &&
+				request(fileArgument) == "completed=1 parsed=0 upToDate=1\n" &&
+				floodingClient.connect(socketPath) &&
+				floodingClient.send(std::string(server.maxRequestLineLength + 1u, 'a')) &&
+				CodeGenProtocol::receiveResult(floodingClient, floodingResult) && !floodingResult.completed &&
+				request(fileArgument) == "completed=1 parsed=0 upToDate=1\n" &&
+				logger.errorCount == 0u;
+
+	server.stop();
+	serverThread.join();
+
+	fs::remove_all(workingDirectory);
+
+	return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>	//std::atoi
+
+#include <Kodgen/Threading/ThreadPool.h>
+#include <Kodgen/Threading/TaskGroup.h>
+
+using namespace kodgen;
+
+/**
+*	@brief Run a scenario and print the wall time spent per task and the number of tasks run per second.
+*
+*	@param name			Name of the scenario.
+*	@param taskCount	Number of tasks submitted by the scenario.
+*	@param scenario		Function submitting the tasks and joining the pool.
+*/
+template <typename Scenario>
+void measure(char const* name, uint64 taskCount, Scenario&& scenario)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	scenario();
+
+	double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count();
+
+	std::cout << name << ": " << taskCount << " tasks, " << static_cast<uint64>(nanoseconds / static_cast<double>(taskCount)) << " ns/task, "
+			  << static_cast<uint64>(static_cast<double>(taskCount) * 1e9 / nanoseconds) << " tasks/s" << std::endl;
+}
+
+/**
+*	Measure the scheduling overhead of the thread pool with empty tasks, so that the measured time is only spent in the pool.
+*	Usage: ThreadingBenchmark [threadCount = 64] [taskCount = 100000]
+*/
+int main(int argc, char** argv)
+{
+	uint32 threadCount	= (argc > 1) ? static_cast<uint32>(std::atoi(argv[1])) : 64u;
+	uint64 taskCount	= (argc > 2) ? static_cast<uint64>(std::atoi(argv[2])) : 100000u;
+
+	ThreadPool threadPool(threadCount);
+
+	std::cout << threadCount << " threads" << std::endl;
+
+	//Submission only, which is mostly spent allocating the tasks
+	threadPool.setIsRunning(false);
+
+	measure("Submission", taskCount, [&]()
+			{
+				for (uint64 i = 0u; i < taskCount; i++)
+				{
+					threadPool.submitTask("Empty", [](TaskBase*) {});
+				}
+			});
+
+	threadPool.setIsRunning(true);
+	threadPool.joinWorkers();
+
+	//Tasks submitted from the main thread while the workers run
+	measure("Submitted from the main thread", taskCount, [&]()
+			{
+				for (uint64 i = 0u; i < taskCount; i++)
+				{
+					threadPool.submitTask("Empty", [](TaskBase*) {});
+				}
+
+				threadPool.joinWorkers();
+			});
+
+	//Tasks submitted from the main thread then released at once, as CodeGenManager does
+	measure("Submitted in batch", taskCount, [&]()
+			{
+				threadPool.setIsRunning(false);
+
+				for (uint64 i = 0u; i < taskCount; i++)
+				{
+					threadPool.submitTask("Empty", [](TaskBase*) {});
+				}
+
+				threadPool.setIsRunning(true);
+				threadPool.joinWorkers();
+			});
+
+	//Same with the main thread running tasks while it joins
+	measure("Submitted in batch, joined by running tasks", taskCount, [&]()
+			{
+				threadPool.setIsRunning(false);
+
+				for (uint64 i = 0u; i < taskCount; i++)
+				{
+					threadPool.submitTask("Empty", [](TaskBase*) {});
+				}
+
+				threadPool.setIsRunning(true);
+				threadPool.joinWorkers(true);
+			});
+
+	//Tasks created then submitted at once, as CodeGenManager does
+	measure("Submitted in bulk, waited as a group", taskCount, [&]()
+			{
+				std::vector<std::shared_ptr<TaskBase>> tasks;
+				tasks.reserve(taskCount);
+
+				for (uint64 i = 0u; i < taskCount; i++)
+				{
+					tasks.emplace_back(ThreadPool::createTask("Empty", [](TaskBase*) {}));
+				}
+
+				TaskGroup group(threadPool);
+
+				group.submitTasks(tasks);
+				group.wait();
+			});
+
+	//Range split in tasks of 32 indices, as the hashing does
+	measure("Parallel for, 32 indices per task", taskCount, [&]()
+			{
+				TaskGroup group(threadPool);
+
+				group.parallelFor(0u, taskCount * 32u, 32u, [](size_t) {});
+				group.wait();
+			});
+
+	//Tasks submitted by other tasks, as the directory discovery does
+	measure("Submitted from tasks", taskCount, [&]()
+			{
+				uint64 const childCount = taskCount / threadCount;
+
+				for (uint32 i = 0u; i < threadCount; i++)
+				{
+					threadPool.submitTask("Parent", [&threadPool, childCount](TaskBase*)
+										  {
+											  for (uint64 j = 1u; j < childCount; j++)
+											  {
+												  threadPool.submitTask("Empty", [](TaskBase*) {});
+											  }
+										  });
+				}
+
+				threadPool.joinWorkers();
+			});
+
+	//Pairs of dependent tasks, as the parsing and generation tasks of a file
+	measure("Dependent pairs", taskCount, [&]()
+			{
+				threadPool.setIsRunning(false);
+
+				for (uint64 i = 0u; i < taskCount / 2u; i++)
+				{
+					std::shared_ptr<TaskBase> first = threadPool.submitTask("First", [](TaskBase*) {});
+
+					threadPool.submitTask("Second", [](TaskBase*) {}, { first });
+				}
+
+				threadPool.setIsRunning(true);
+				threadPool.joinWorkers();
+			});
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
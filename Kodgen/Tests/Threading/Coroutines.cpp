@@ -0,0 +1,73 @@
+#include <iostream>
+#include <atomic>
+#include <stdexcept>	//std::runtime_error
+
+#include <Kodgen/Threading/AsyncTask.h>
+
+using namespace kodgen;
+
+static AsyncTask<int> parse(ThreadPool& threadPool, int value)
+{
+	std::shared_ptr<TaskBase> parsing = threadPool.submitTask("Parse", [value](TaskBase*) { return value * 2; });
+
+	int parsedValue = co_await TaskAwaiter<int>(parsing);
+
+	co_return parsedValue + 1;
+}
+
+static AsyncTask<void> generate(ThreadPool& threadPool, std::atomic_int& out_sum)
+{
+	AsyncTask<int> first	= parse(threadPool, 1);
+	AsyncTask<int> second	= parse(threadPool, 2);
+
+	out_sum += co_await first;
+	out_sum += co_await second;
+}
+
+static AsyncTask<int> fail(ThreadPool&)
+{
+	throw std::runtime_error("Thrown by a coroutine");
+
+	co_return 0;
+}
+
+static AsyncTask<bool> catchFailure(ThreadPool& threadPool)
+{
+	try
+	{
+		co_await fail(threadPool);
+	}
+	catch (std::runtime_error const&)
+	{
+		co_return true;
+	}
+
+	co_return false;
+}
+
+int main()
+{
+	//Coroutines run the same way on workers and on a pool without worker, whose tasks are run by the joining thread
+	for (uint32 threadCount : { 4u, 0u })
+	{
+		ThreadPool			threadPool(threadCount);
+		std::atomic_int		sum = 0;
+
+		AsyncTask<void>		generation		= generate(threadPool, sum);
+		AsyncTask<bool>		failureCatching	= catchFailure(threadPool);
+
+		//Coroutine completions are regular tasks, so that they can be depended on
+		std::shared_ptr<TaskBase> afterGeneration = threadPool.submitTask("After generation", [&sum](TaskBase*) { return sum.load(); }, { generation.getTask() });
+
+		threadPool.joinWorkers();
+
+		if (!generation.getTask()->hasFinished() || TaskHelper::getResult<int>(afterGeneration.get()) != 8 || !TaskHelper::getResult<bool>(failureCatching.getTask().get()))
+		{
+			std::cerr << "Coroutines did not complete as expected with " << threadCount << " workers." << std::endl;
+
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
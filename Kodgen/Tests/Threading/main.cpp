@@ -1,10 +1,20 @@
 #include <iostream>
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <string>
+#include <chrono>
+#include <stdexcept>	//std::runtime_error
 
 #include <Kodgen/Threading/ThreadPool.h>
+#include <Kodgen/Threading/TaskGroup.h>
 #include <Kodgen/Threading/TaskHelper.h>
 
 using namespace kodgen;
 
+//Constructed before the first task allocation, so destroyed after the static objects of the task allocator if it had any
+static ThreadPool staticThreadPool(0u);
+
 struct A
 {
 
@@ -42,5 +52,350 @@ int main()
 	//A is not callable, doesn't compile
 	//auto t4 = threadPool.submitTask(A());
 
+	threadPool.joinWorkers();
+
+	//Tasks submitted by tasks are run as well, and dependent tasks run after their dependencies wherever they are queued
+	constexpr uint32 const chainCount	= 64u;
+	constexpr uint32 const chainLength	= 16u;
+
+	std::atomic_uint		executedTaskCount	= 0u;
+	std::vector<uint32>		chainProgress(chainCount, 0u);
+	std::atomic_bool		isOrderRespected	= true;
+
+	for (uint32 i = 0u; i < chainCount; i++)
+	{
+		threadPool.submitTask("Chain", [&, i](TaskBase*)
+							  {
+								  std::shared_ptr<TaskBase> previousTask;
+
+								  for (uint32 j = 0u; j < chainLength; j++)
+								  {
+									  std::vector<std::shared_ptr<TaskBase>> dependencies;
+
+									  if (previousTask != nullptr)
+									  {
+										  dependencies.push_back(previousTask);
+									  }
+
+									  previousTask = threadPool.submitTask("Chain link", [&, i, j](TaskBase*)
+																		   {
+																			   if (chainProgress[i] != j)
+																			   {
+																				   isOrderRespected = false;
+																			   }
+
+																			   chainProgress[i]++;
+																			   executedTaskCount++;
+																		   }, std::move(dependencies));
+								  }
+							  });
+	}
+
+	threadPool.joinWorkers();
+
+	if (executedTaskCount != chainCount * chainLength || !isOrderRespected)
+	{
+		std::cerr << "Dependent tasks were not executed in order: " << executedTaskCount << " tasks executed." << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	//A group completes once its tasks and the tasks submitted to it by its tasks completed
+	constexpr uint32 const	rangeSize			= 1000u;
+	constexpr uint32 const	nestedTaskCount		= 16u;
+
+	std::vector<uint32>		squares(rangeSize, 0u);
+	std::atomic_uint		executedNestedTaskCount	= 0u;
+
+	{
+		TaskGroup group(threadPool);
+
+		group.parallelFor(0u, rangeSize, 64u, [&squares](size_t i) { squares[i] = static_cast<uint32>(i * i); });
+
+		group.submitTask("Parent", [&](TaskBase*)
+						 {
+							 for (uint32 i = 0u; i < nestedTaskCount; i++)
+							 {
+								 group.submitTask("Nested", [&](TaskBase*) { executedNestedTaskCount++; });
+							 }
+						 });
+
+		group.wait();
+
+		for (uint32 i = 0u; i < rangeSize; i++)
+		{
+			if (squares[i] != i * i)
+			{
+				std::cerr << "Parallel for skipped index " << i << "." << std::endl;
+
+				return EXIT_FAILURE;
+			}
+		}
+
+		if (executedNestedTaskCount != nestedTaskCount)
+		{
+			std::cerr << "Group completed before its nested tasks: " << executedNestedTaskCount << " nested tasks executed." << std::endl;
+
+			return EXIT_FAILURE;
+		}
+	}
+
+	//Ready tasks of higher priority run first, whatever their submission order
+	{
+		ThreadPool				singleWorkerPool(1u);
+		std::vector<uint32>		executionOrder;
+
+		singleWorkerPool.setIsCollectingStatistics(true);
+		singleWorkerPool.setIsRunning(false);
+
+		singleWorkerPool.submitTask("Low", [&executionOrder](TaskBase*) { executionOrder.push_back(0u); }, {}, ETaskPriority::Low);
+		singleWorkerPool.submitTask("Normal", [&executionOrder](TaskBase*) { executionOrder.push_back(1u); });
+		singleWorkerPool.submitTask("High", [&executionOrder](TaskBase*) { executionOrder.push_back(2u); }, {}, ETaskPriority::High);
+
+		singleWorkerPool.setIsRunning(true);
+		singleWorkerPool.joinWorkers();
+
+		if (executionOrder != std::vector<uint32>{ 2u, 1u, 0u })
+		{
+			std::cerr << "Tasks were not executed by priority." << std::endl;
+
+			return EXIT_FAILURE;
+		}
+
+		ThreadPoolStatistics statistics = singleWorkerPool.getStatistics();
+
+		if (statistics.workers[0].executedTaskCount != 3u || statistics.maxQueuedTaskCount != 3u)
+		{
+			std::cerr << "Thread pool statistics were not collected." << std::endl;
+
+			return EXIT_FAILURE;
+		}
+	}
+
+	//A pool without worker runs its tasks on the threads waiting for them
+	{
+		ThreadPool				inlinePool(0u);
+		std::thread::id const	callingThreadId		= std::this_thread::get_id();
+		std::atomic_uint		inlineTaskCount		= 0u;
+		std::atomic_bool		isRunInline			= true;
+
+		auto inlineTask = [&](TaskBase*)
+		{
+			isRunInline = isRunInline && std::this_thread::get_id() == callingThreadId;
+			inlineTaskCount++;
+		};
+
+		std::shared_ptr<TaskBase> first = inlinePool.submitTask("First", inlineTask);
+		inlinePool.submitTask("Second", inlineTask, { first });
+		inlinePool.joinWorkers();
+
+		TaskGroup group(inlinePool);
+
+		group.parallelFor(0u, 8u, 2u, [&inlineTask](size_t) { inlineTask(nullptr); });
+		group.wait();
+
+		if (inlineTaskCount != 10u || !isRunInline)
+		{
+			std::cerr << "Tasks of a pool without worker were not run by the calling thread." << std::endl;
+
+			return EXIT_FAILURE;
+		}
+	}
+
+	//Workers can be added and removed while tasks run, and idle workers exit until tasks are queued again
+	{
+		ThreadPool			elasticPool(1u, ETerminationMode::FinishAll, 4u);
+		std::atomic_uint	elasticTaskCount = 0u;
+
+		{
+			TaskGroup group(elasticPool);
+
+			group.parallelFor(0u, 64u, 1u, [&elasticTaskCount](size_t)
+							  {
+								  std::this_thread::sleep_for(std::chrono::microseconds(100));
+								  elasticTaskCount++;
+							  });
+
+			elasticPool.setWorkerCount(4u);
+
+			//The tasks left once all workers exited are run by the waiting thread
+			elasticPool.setWorkerCount(0u);
+			group.wait();
+		}
+
+		elasticPool.setWorkerCount(2u);
+		elasticPool.setIdleTimeout(std::chrono::milliseconds(1));
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+		//Joining without running tasks only returns if a worker has been spawned again to run the task
+		elasticPool.submitTask("After idle", [&elasticTaskCount](TaskBase*) { elasticTaskCount++; });
+		elasticPool.joinWorkers();
+
+		if (elasticTaskCount != 65u || elasticPool.getWorkerCount() != 2u)
+		{
+			std::cerr << "Tasks were not run while the worker count changed." << std::endl;
+
+			return EXIT_FAILURE;
+		}
+
+		//Stopping the workers waits for the running task, and keeps the worker count so that workers are spawned again for new tasks
+		std::atomic_bool isTaskStarted = false;
+
+		elasticPool.submitTask("Before stop", [&elasticTaskCount, &isTaskStarted](TaskBase*)
+							   {
+								   isTaskStarted = true;
+								   std::this_thread::sleep_for(std::chrono::milliseconds(10));
+								   elasticTaskCount++;
+							   });
+
+		while (!isTaskStarted)
+		{
+			std::this_thread::yield();
+		}
+
+		elasticPool.stopWorkers();
+
+		bool isRunningTaskFinished = (elasticTaskCount == 66u);
+
+		elasticPool.submitTask("After stop", [&elasticTaskCount](TaskBase*) { elasticTaskCount++; });
+		elasticPool.joinWorkers();
+
+		if (!isRunningTaskFinished || elasticTaskCount != 67u || elasticPool.getWorkerCount() != 2u)
+		{
+			std::cerr << "Tasks were not run around stopping the workers." << std::endl;
+
+			return EXIT_FAILURE;
+		}
+	}
+
+	//Names which don't outlive the task are copied in the task, including names too long for the small string optimization
+	{
+		std::string					shortName	= "Owned";
+		std::string					longName	= "Owned name, long enough not to fit in the string object";
+		std::shared_ptr<TaskBase>	shortTask	= threadPool.submitTask(std::string(shortName), [](TaskBase*) {});
+		std::shared_ptr<TaskBase>	longTask	= ThreadPool::createTask(longName + "", [](TaskBase*) {});
+
+		threadPool.joinWorkers();
+
+		if (shortName != shortTask->getName() || longName != longTask->getName())
+		{
+			std::cerr << "Task names were not copied." << std::endl;
+
+			return EXIT_FAILURE;
+		}
+	}
+
+	//Results and exceptions are kept in the task until they are retrieved, even for callables bigger than a pooled block
+	char bigCapture[2048] = "Big capture";
+
+	auto t5 = threadPool.submitTask("Big capture", [bigCapture](TaskBase*) { return std::string(bigCapture); });
+	auto t6 = threadPool.submitTask("Throw", [](TaskBase*) -> int { throw std::runtime_error("Thrown by a task"); });
+
+	threadPool.joinWorkers();
+
+	bool isExceptionPropagated = false;
+
+	try
+	{
+		TaskHelper::getResult<int>(t6.get());
+	}
+	catch (std::runtime_error const&)
+	{
+		isExceptionPropagated = true;
+	}
+
+	if (TaskHelper::getResult<std::string>(t5.get()) != "Big capture" || !isExceptionPropagated)
+	{
+		std::cerr << "Task results were not retrieved." << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	//Retrieving the result of a task which has not finished waits for it
+	auto t7 = threadPool.submitTask("Slow", [](TaskBase*)
+									{
+										std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+										return 7;
+									});
+
+	if (TaskHelper::getResult<int>(t7.get()) != 7)
+	{
+		std::cerr << "Task result was retrieved before the task finished." << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	//Tasks discarded by a destroyed pool report a broken promise
+	std::shared_ptr<TaskBase>	t8;
+	bool						isDiscardReported = false;
+
+	{
+		ThreadPool discardingPool(0u, ETerminationMode::FinishCurrent);
+
+		t8 = discardingPool.submitTask("Discarded", [](TaskBase*) { return 8; });
+	}
+
+	try
+	{
+		TaskHelper::getResult<int>(t8.get());
+	}
+	catch (std::future_error const& error)
+	{
+		isDiscardReported = error.code() == std::future_errc::broken_promise;
+	}
+
+	if (!isDiscardReported)
+	{
+		std::cerr << "The result of a discarded task was retrieved." << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	//Threads which are not workers share the same worker index, and the thread waiting for a group is the only one of them running its tasks
+	{
+		ThreadPool				indexPool(2u);
+		std::thread::id const	waitingThreadId		= std::this_thread::get_id();
+		std::atomic_bool		isIndexRespected	= true;
+
+		std::thread otherThread([&indexPool, &isIndexRespected]()
+								{
+									if (indexPool.getCurrentWorkerIndex() != indexPool.getMaxWorkerCount())
+									{
+										isIndexRespected = false;
+									}
+								});
+
+		TaskGroup group(indexPool);
+
+		group.parallelFor(0u, 256u, 1u, [&](size_t)
+						  {
+							  uint32 workerIndex = indexPool.getCurrentWorkerIndex();
+
+							  if (workerIndex > indexPool.getMaxWorkerCount() ||
+								  (workerIndex == indexPool.getMaxWorkerCount() && std::this_thread::get_id() != waitingThreadId))
+							  {
+								  isIndexRespected = false;
+							  }
+						  });
+
+		group.wait();
+		otherThread.join();
+
+		if (!isIndexRespected || indexPool.getCurrentWorkerIndex() != indexPool.getMaxWorkerCount())
+		{
+			std::cerr << "A task run by a thread which is not a worker got a worker index, or was not run by the waiting thread." << std::endl;
+
+			return EXIT_FAILURE;
+		}
+	}
+
+	//Run by the destructor of the static pool, once main returned
+	for (uint32 i = 0u; i < 256u; i++)
+	{
+		staticThreadPool.submitTask("At exit", [](TaskBase*) {});
+	}
+
 	return EXIT_SUCCESS;
 }
\ No newline at end of file